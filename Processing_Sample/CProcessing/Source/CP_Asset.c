@@ -0,0 +1,437 @@
+//------------------------------------------------------------------------------
+// file:	CP_Asset.c
+// author:	Justin Chambers
+// brief:	Registry of loaded images, sounds and fonts shared by their modules
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+#define CP_ASSET_INITIAL_COUNT	64
+#define CP_ASSET_INDEX_MIN		128			// slots in the hash tables, always a power of two
+#define CP_ASSET_TOMBSTONE		-1			// index slot of an asset that was released
+#define CP_INTERN_BLOCK_SIZE	16384		// bytes of path storage allocated at a time
+
+// Registered assets live in one array, released entries are linked into a free list and reused
+// by the next asset. The index maps a type and an interned path to an entry.
+typedef struct CP_AssetEntry
+{
+	const char* path;		// interned, NULL for assets not loaded from a file
+	unsigned hash;			// of the path and type
+	CP_ASSET_TYPE type;		// CP_ASSET_TYPE_MAX while the entry is free
+	int refs;
+	void* data;
+	int next_free;
+} CP_AssetEntry;
+
+// Paths are copied once into large blocks and compared by pointer afterwards
+typedef struct CP_InternBlock
+{
+	struct CP_InternBlock* next;
+	size_t used;
+	size_t size;
+	char data[1];
+} CP_InternBlock;
+
+static CP_AssetEntry* entries = NULL;
+static int entry_count = 0;			// entries ever used, free ones included
+static int entry_max = 0;
+static int free_head = CP_ASSET_NONE;
+
+static int* index_slots = NULL;		// entry id + 1, 0 when empty or CP_ASSET_TOMBSTONE
+static int index_max = 0;
+static int index_used = 0;			// live and released slots, both lengthen probes
+
+static const char** intern_slots = NULL;
+static unsigned* intern_hashes = NULL;
+static int intern_max = 0;
+static int intern_count = 0;
+static CP_InternBlock* intern_blocks = NULL;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+// FNV-1a
+static unsigned CP_Asset_HashString(const char* s)
+{
+	unsigned hash = 2166136261u;
+	while (*s)
+	{
+		hash ^= (unsigned char)*s++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static unsigned CP_Asset_HashKey(unsigned pathHash, CP_ASSET_TYPE type)
+{
+	unsigned hash = pathHash ^ ((unsigned)type * 0x9E3779B9u);
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	return hash;
+}
+
+// Returns the interned copy of s, NULL if it was never interned
+static const char* CP_Asset_FindIntern(const char* s, unsigned hash)
+{
+	if (intern_max == 0)
+	{
+		return NULL;
+	}
+
+	unsigned mask = (unsigned)intern_max - 1;
+	for (unsigned i = hash & mask;; i = (i + 1) & mask)
+	{
+		if (!intern_slots[i])
+		{
+			return NULL;
+		}
+		if (intern_hashes[i] == hash && !strcmp(intern_slots[i], s))
+		{
+			return intern_slots[i];
+		}
+	}
+}
+
+static CP_BOOL CP_Asset_GrowIntern(void)
+{
+	int max = intern_max ? intern_max * 2 : CP_ASSET_INDEX_MIN;
+	const char** slots = (const char**)calloc(max, sizeof(const char*));
+	unsigned* hashes = (unsigned*)calloc(max, sizeof(unsigned));
+	if (!slots || !hashes)
+	{
+		free((void*)slots);
+		free(hashes);
+		return FALSE;
+	}
+
+	unsigned mask = (unsigned)max - 1;
+	for (int i = 0; i < intern_max; ++i)
+	{
+		if (!intern_slots[i])
+		{
+			continue;
+		}
+		unsigned j = intern_hashes[i] & mask;
+		while (slots[j])
+		{
+			j = (j + 1) & mask;
+		}
+		slots[j] = intern_slots[i];
+		hashes[j] = intern_hashes[i];
+	}
+
+	free((void*)intern_slots);
+	free(intern_hashes);
+	intern_slots = slots;
+	intern_hashes = hashes;
+	intern_max = max;
+	return TRUE;
+}
+
+static const char* CP_Asset_Intern(const char* s, unsigned hash)
+{
+	const char* interned = CP_Asset_FindIntern(s, hash);
+	if (interned)
+	{
+		return interned;
+	}
+
+	// keep the table at most half full
+	if ((intern_count + 1) * 2 > intern_max && !CP_Asset_GrowIntern())
+	{
+		return NULL;
+	}
+
+	size_t length = strlen(s) + 1;
+	if (!intern_blocks || intern_blocks->size - intern_blocks->used < length)
+	{
+		size_t size = length > CP_INTERN_BLOCK_SIZE ? length : CP_INTERN_BLOCK_SIZE;
+		CP_InternBlock* block = (CP_InternBlock*)malloc(sizeof(CP_InternBlock) + size);
+		if (!block)
+		{
+			return NULL;
+		}
+		block->next = intern_blocks;
+		block->used = 0;
+		block->size = size;
+		intern_blocks = block;
+	}
+
+	char* copy = &intern_blocks->data[intern_blocks->used];
+	memcpy(copy, s, length);
+	intern_blocks->used += length;
+
+	unsigned mask = (unsigned)intern_max - 1;
+	unsigned i = hash & mask;
+	while (intern_slots[i])
+	{
+		i = (i + 1) & mask;
+	}
+	intern_slots[i] = copy;
+	intern_hashes[i] = hash;
+	++intern_count;
+	return copy;
+}
+
+// Returns the index slot holding the type and interned path, or -1
+static int CP_Asset_FindSlot(CP_ASSET_TYPE type, const char* path, unsigned hash)
+{
+	if (index_max == 0)
+	{
+		return -1;
+	}
+
+	unsigned mask = (unsigned)index_max - 1;
+	for (unsigned i = hash & mask;; i = (i + 1) & mask)
+	{
+		int slot = index_slots[i];
+		if (slot == 0)
+		{
+			return -1;
+		}
+		if (slot != CP_ASSET_TOMBSTONE)
+		{
+			const CP_AssetEntry* entry = &entries[slot - 1];
+			if (entry->hash == hash && entry->type == type && entry->path == path)
+			{
+				return (int)i;
+			}
+		}
+	}
+}
+
+static void CP_Asset_InsertSlot(int id)
+{
+	unsigned mask = (unsigned)index_max - 1;
+	unsigned i = entries[id].hash & mask;
+	while (index_slots[i] > 0)
+	{
+		i = (i + 1) & mask;
+	}
+	if (index_slots[i] == 0)
+	{
+		++index_used;
+	}
+	index_slots[i] = id + 1;
+}
+
+// Rebuilds the index twice as large, or the same size when it is mostly released slots
+static CP_BOOL CP_Asset_RebuildIndex(void)
+{
+	int live = 0;
+	for (int i = 0; i < index_max; ++i)
+	{
+		live += index_slots[i] > 0;
+	}
+	int max = index_max ? index_max : CP_ASSET_INDEX_MIN;
+	while ((live + 1) * 2 > max)
+	{
+		max *= 2;
+	}
+
+	int* old = index_slots;
+	int oldMax = index_max;
+	index_slots = (int*)calloc(max, sizeof(int));
+	if (!index_slots)
+	{
+		index_slots = old;
+		return FALSE;
+	}
+	index_max = max;
+	index_used = 0;
+
+	for (int i = 0; i < oldMax; ++i)
+	{
+		if (old[i] > 0)
+		{
+			CP_Asset_InsertSlot(old[i] - 1);
+		}
+	}
+	free(old);
+	return TRUE;
+}
+
+static int CP_Asset_NewEntry(void)
+{
+	if (free_head != CP_ASSET_NONE)
+	{
+		int id = free_head;
+		free_head = entries[id].next_free;
+		return id;
+	}
+
+	if (entry_count == entry_max)
+	{
+		int max = entry_max ? entry_max * 2 : CP_ASSET_INITIAL_COUNT;
+		CP_AssetEntry* temp = (CP_AssetEntry*)realloc(entries, max * sizeof(CP_AssetEntry));
+		if (!temp)
+		{
+			return CP_ASSET_NONE;
+		}
+		entries = temp;
+		entry_max = max;
+	}
+	return entry_count++;
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+void CP_Asset_Shutdown(void)
+{
+	free(entries);
+	entries = NULL;
+	entry_count = entry_max = 0;
+	free_head = CP_ASSET_NONE;
+
+	free(index_slots);
+	index_slots = NULL;
+	index_max = index_used = 0;
+
+	free((void*)intern_slots);
+	free(intern_hashes);
+	intern_slots = NULL;
+	intern_hashes = NULL;
+	intern_max = intern_count = 0;
+	while (intern_blocks)
+	{
+		CP_InternBlock* next = intern_blocks->next;
+		free(intern_blocks);
+		intern_blocks = next;
+	}
+}
+
+void* CP_Asset_Acquire(CP_ASSET_TYPE type, const char* path)
+{
+	if (!path)
+	{
+		return NULL;
+	}
+
+	unsigned pathHash = CP_Asset_HashString(path);
+	const char* interned = CP_Asset_FindIntern(path, pathHash);
+	if (!interned)
+	{
+		return NULL;
+	}
+
+	int slot = CP_Asset_FindSlot(type, interned, CP_Asset_HashKey(pathHash, type));
+	if (slot < 0)
+	{
+		return NULL;
+	}
+
+	CP_AssetEntry* entry = &entries[index_slots[slot] - 1];
+	++entry->refs;
+	return entry->data;
+}
+
+int CP_Asset_Add(CP_ASSET_TYPE type, const char* path, void* data)
+{
+	const char* interned = NULL;
+	unsigned hash = 0;
+	if (path)
+	{
+		unsigned pathHash = CP_Asset_HashString(path);
+		interned = CP_Asset_Intern(path, pathHash);
+		if (!interned)
+		{
+			return CP_ASSET_NONE;
+		}
+		hash = CP_Asset_HashKey(pathHash, type);
+
+		// keep the index at most half full, released slots included
+		if ((index_used + 1) * 2 > index_max && !CP_Asset_RebuildIndex())
+		{
+			return CP_ASSET_NONE;
+		}
+	}
+
+	int id = CP_Asset_NewEntry();
+	if (id == CP_ASSET_NONE)
+	{
+		return CP_ASSET_NONE;
+	}
+
+	CP_AssetEntry* entry = &entries[id];
+	entry->path = interned;
+	entry->hash = hash;
+	entry->type = type;
+	entry->refs = 1;
+	entry->data = data;
+	entry->next_free = CP_ASSET_NONE;
+
+	if (interned)
+	{
+		CP_Asset_InsertSlot(id);
+	}
+	return id;
+}
+
+int CP_Asset_Release(int id)
+{
+	if (id < 0 || id >= entry_count || entries[id].type == CP_ASSET_TYPE_MAX)
+	{
+		return 0;
+	}
+
+	CP_AssetEntry* entry = &entries[id];
+	if (--entry->refs > 0)
+	{
+		return entry->refs;
+	}
+
+	if (entry->path)
+	{
+		int slot = CP_Asset_FindSlot(entry->type, entry->path, entry->hash);
+		if (slot >= 0)
+		{
+			index_slots[slot] = CP_ASSET_TOMBSTONE;
+		}
+	}
+
+	entry->path = NULL;
+	entry->type = CP_ASSET_TYPE_MAX;
+	entry->data = NULL;
+	entry->next_free = free_head;
+	free_head = id;
+	return 0;
+}
+
+const char* CP_Asset_GetPath(int id)
+{
+	if (id < 0 || id >= entry_count)
+	{
+		return NULL;
+	}
+	return entries[id].path;
+}
+
+void* CP_Asset_Next(CP_ASSET_TYPE type, int* cursor)
+{
+	while (*cursor < entry_count)
+	{
+		const CP_AssetEntry* entry = &entries[(*cursor)++];
+		if (entry->type == type)
+		{
+			return entry->data;
+		}
+	}
+	return NULL;
+}
@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+// file:	CP_Canvas.c
+// author:	Justin Chambers
+// brief:	Offscreen canvases for layers that are drawn once and reused
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+#include "nanovg_gl_utils.h"
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+// the canvas being drawn into, NULL while drawing to the screen
+static CP_Canvas active_canvas = NULL;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+// A GL framebuffer to bind and its size, the screen when framebuffer is NULL
+typedef struct CP_CanvasTarget
+{
+	struct NVGLUframebuffer* framebuffer;
+	struct NVGLUframebuffer* restore;	// bound again after creating a framebuffer
+	CP_Canvas canvas;					// the canvas to create a framebuffer for
+	int w, h;
+} CP_CanvasTarget;
+
+// These run where the GL context is current, see CP_Render_Call
+static void CP_Canvas_Bind(struct NVGLUframebuffer* framebuffer)
+{
+	if (framebuffer)
+	{
+		nvgluBindFramebuffer(framebuffer);
+	}
+	else
+	{
+		CP_Render_BindScreen();
+	}
+}
+
+static void CP_Canvas_BindFramebuffer(void* data)
+{
+	const CP_CanvasTarget* target = (const CP_CanvasTarget*)data;
+	CP_Canvas_Bind(target->framebuffer);
+	glViewport(0, 0, target->w, target->h);
+}
+
+static void CP_Canvas_CreateFramebuffer(void* data)
+{
+	const CP_CanvasTarget* target = (const CP_CanvasTarget*)data;
+	CP_Canvas canvas = target->canvas;
+
+	canvas->framebuffer = nvgluCreateFramebuffer(CP_Render_Context(), target->w, target->h, 0);
+	if (canvas->framebuffer)
+	{
+		nvgluBindFramebuffer(canvas->framebuffer);
+		glClearColor(0, 0, 0, 0);
+		glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+		CP_Canvas_Bind(target->restore);
+	}
+}
+
+static void CP_Canvas_DeleteFramebuffer(void* data)
+{
+	const CP_CanvasTarget* target = (const CP_CanvasTarget*)data;
+
+	// the image is deleted with the engine's context, which is where it is drawn from
+	target->framebuffer->image = -1;
+	nvgluDeleteFramebuffer(target->framebuffer);
+}
+
+// Binds the render target of a canvas, or the screen for NULL
+static void CP_Canvas_BindTarget(CP_Canvas canvas)
+{
+	CP_CorePtr CORE = GetCPCore();
+
+	if (CORE->isHeadless)
+	{
+		nvgswBindTarget(CORE->nvg, canvas ? canvas->image.handle : 0);
+		return;
+	}
+
+	CP_CanvasTarget target;
+	memset(&target, 0, sizeof(target));
+	target.framebuffer = canvas ? canvas->framebuffer : NULL;
+	target.w = canvas ? canvas->image.w : CORE->canvas_width;
+	target.h = canvas ? canvas->image.h : CORE->canvas_height;
+	CP_Render_Call(CP_Canvas_BindFramebuffer, &target, sizeof(target));
+}
+
+//------------------------------------------------------------------------------
+// Library Functions:
+//------------------------------------------------------------------------------
+
+CP_API CP_Canvas CP_Canvas_Create(int w, int h)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!CORE || !CORE->nvg || w <= 0 || h <= 0)
+	{
+		return NULL;
+	}
+
+	CP_Canvas canvas = (CP_Canvas)malloc(sizeof(CP_Canvas_Struct));
+	if (!canvas)
+	{
+		return NULL;
+	}
+	memset(canvas, 0, sizeof(CP_Canvas_Struct));
+
+	if (CORE->isHeadless)
+	{
+		// the software renderer draws straight into the image, which starts out transparent
+		canvas->image.handle = nvgCreateImageRGBA(CORE->nvg, w, h, NVG_IMAGE_PREMULTIPLIED, NULL);
+	}
+	else
+	{
+		// the framebuffer is created on the render context, waiting for it when threaded
+		CP_CanvasTarget target;
+		memset(&target, 0, sizeof(target));
+		target.restore = active_canvas ? active_canvas->framebuffer : NULL;
+		target.canvas = canvas;
+		target.w = w;
+		target.h = h;
+		CP_Render_Call(CP_Canvas_CreateFramebuffer, &target, sizeof(target));
+		CP_Render_Sync();
+
+		if (canvas->framebuffer)
+		{
+			// GL framebuffers store their rows bottom to top
+			canvas->image.handle = CP_Render_ImportImage(canvas->framebuffer->image, w, h, NVG_IMAGE_FLIPY | NVG_IMAGE_PREMULTIPLIED);
+			canvas->image.flip_y = TRUE;
+		}
+	}
+
+	if (canvas->image.handle == 0)
+	{
+		free(canvas);
+		return NULL;
+	}
+
+	canvas->image.w = w;
+	canvas->image.h = h;
+	canvas->image.load_error = FALSE;
+	canvas->image.status = CP_IMAGE_READY;
+	canvas->image.load = NULL;
+	canvas->image.atlas = NULL;
+	canvas->image.evicted = FALSE;
+	canvas->image.lru_prev = canvas->image.lru_next = NULL;
+	canvas->image.filepath = NULL;
+	canvas->image.asset = CP_ASSET_NONE;	// owned by the canvas, not the asset registry
+	canvas->dirty = TRUE;
+
+	return canvas;
+}
+
+CP_API void CP_Canvas_Free(CP_Canvas* canvas)
+{
+	if (canvas == NULL || *canvas == NULL)
+	{
+		return;
+	}
+
+	CP_CorePtr CORE = GetCPCore();
+	if (*canvas == active_canvas)
+	{
+		CP_Canvas_End();
+	}
+
+	// batched sprites can still be reading from the canvas
+	CP_Image_FlushBatch();
+
+	if ((*canvas)->framebuffer)
+	{
+		CP_CanvasTarget target;
+		memset(&target, 0, sizeof(target));
+		target.framebuffer = (*canvas)->framebuffer;
+		CP_Render_Call(CP_Canvas_DeleteFramebuffer, &target, sizeof(target));
+	}
+	nvgDeleteImage(CORE->nvg, (*canvas)->image.handle);
+
+	free(*canvas);
+	*canvas = NULL;
+}
+
+// Drawing goes to the canvas until CP_Canvas_End, starting from an identity transform with
+// the current colors and settings. The canvas keeps its contents until it is cleared with
+// CP_Graphics_ClearBackground while it is being drawn into.
+CP_API void CP_Canvas_Begin(CP_Canvas canvas)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!canvas || !CORE || !CORE->nvg || active_canvas)
+	{
+		return;
+	}
+
+	// everything drawn so far goes to the screen
+	CP_Image_FlushBatch();
+	nvgFlush(CORE->nvg);
+
+	CP_Canvas_BindTarget(canvas);
+	nvgViewport(CORE->nvg, canvas->image.w, canvas->image.h, 1.0f);
+	CP_Cull_SetViewport((float)canvas->image.w, (float)canvas->image.h);
+	active_canvas = canvas;
+
+	CP_Settings_Save();
+	CP_Settings_ResetMatrix();
+	nvgResetScissor(CORE->nvg);
+}
+
+CP_API void CP_Canvas_End(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!active_canvas || !CORE || !CORE->nvg)
+	{
+		return;
+	}
+
+	// render what was drawn into the canvas before switching back
+	CP_Image_FlushBatch();
+	nvgFlush(CORE->nvg);
+
+	CP_Canvas_BindTarget(NULL);
+	nvgViewport(CORE->nvg, CORE->window_width, CORE->window_height, CORE->pixel_ratio);
+	CP_Cull_SetViewport((float)CORE->window_width, (float)CORE->window_height);
+	active_canvas->dirty = FALSE;
+	active_canvas = NULL;
+
+	CP_Settings_Restore();
+	CP_Input_SetWorldMouseDirty();
+}
+
+CP_API CP_Image CP_Canvas_GetImage(CP_Canvas canvas)
+{
+	return canvas ? &canvas->image : NULL;
+}
+
+// Canvases start out dirty and are clean once drawn into, layers that change call this
+// to be drawn again, every frame or at whatever rate they need
+CP_API void CP_Canvas_SetDirty(CP_Canvas canvas)
+{
+	if (canvas)
+	{
+		canvas->dirty = TRUE;
+	}
+}
+
+CP_API CP_BOOL CP_Canvas_IsDirty(CP_Canvas canvas)
+{
+	return canvas && canvas->dirty ? TRUE : FALSE;
+}
@@ -10,6 +10,9 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <stdlib.h>
 #include "cprocessing.h"
 #include "Internal_System.h"
 
@@ -18,11 +21,83 @@
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------
 
 static CP_BOOL firstVertex = FALSE;
+static float shapeBounds[4] = { 0 };	// min x, min y, max x, max y of the shape's vertices
+
+// Batched shapes are submitted as one textured triangle list per call. The per shape colors are
+// stored in palette textures, two texels per color: the color itself and the same color with zero
+// alpha. Antialiased edges interpolate between the two texels to fade out.
+#define CP_PALETTE_WIDTH		256
+#define CP_PALETTE_HEIGHT		64
+#define CP_PALETTE_COLORS		((CP_PALETTE_WIDTH / 2) * CP_PALETTE_HEIGHT)
+#define CP_BATCH_MIN_SEGMENTS	8
+#define CP_BATCH_MAX_SEGMENTS	256
+#define CP_BATCH_MAX_POINTS		(2 * CP_BATCH_MAX_SEGMENTS + 8)
+
+typedef struct CP_Palette
+{
+	int image;
+	unsigned char* pixels;
+} CP_Palette;
+
+// Texture coordinates of a palette entry, only valid while serial matches palette_serial
+typedef struct CP_BatchColor
+{
+	float u_inner;
+	float u_outer;
+	float v;
+	unsigned serial;
+	CP_Color color;
+} CP_BatchColor;
+
+// Palettes are filled front to back during a frame and reused on the next one, the texture
+// updates are immediate while the draws are deferred until the end of the frame
+static CP_Palette* palettes = NULL;
+static int palette_count = 0;
+static int palette_index = 0;
+static int palette_used = 0;
+static int palette_uploaded = 0;
+static unsigned palette_frame = 0;
+static unsigned palette_serial = 1;
+
+static NVGvertex* batch_verts = NULL;
+static int batch_count = 0;
+static int batch_capacity = 0;
+static float batch_fringe = 0;		// width of the antialiased edge in local units, 0 when disabled
+static float batch_tolerance = 0;	// curve tessellation tolerance in local units
 
 //------------------------------------------------------------------------------
 // Internal Functions:
 //------------------------------------------------------------------------------
 
+// How far a stroke can reach past its points. Miter joins reach out to the miter limit, and
+// the corner of a square cap is half the width along and across the line, further on diagonals.
+static float CP_Graphics_StrokeReachOf(float halfWidth, int lineCap, int lineJoin, float miterLimit)
+{
+	float reach = halfWidth;
+	if (lineCap == NVG_SQUARE)
+		reach = halfWidth * 1.4142f;
+	if (lineJoin == NVG_MITER)
+		reach = fmaxf(reach, halfWidth * fmaxf(1.0f, miterLimit));
+	return reach;
+}
+
+// How far the current stroke can reach past the points of a shape, only open ones have caps
+float CP_Graphics_StrokeReach(CP_BOOL open)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!GetDrawInfo()->stroke)
+		return 0;
+
+	return CP_Graphics_StrokeReachOf(nvgCurrentStrokeWidth(CORE->nvg) * 0.5f, open ? nvgCurrentLineCap(CORE->nvg) : NVG_BUTT,
+		nvgCurrentLineJoin(CORE->nvg), nvgCurrentMiterLimit(CORE->nvg));
+}
+
+// Lines have caps but no joins
+static float CP_Graphics_LineReach(float halfWidth)
+{
+	return CP_Graphics_StrokeReachOf(halfWidth, nvgCurrentLineCap(GetCPCore()->nvg), NVG_BEVEL, 0);
+}
+
 static void CP_Graphics_DrawRectInternal(float x, float y, float w, float h, float degrees, float cornerRadius)
 {
 	CP_CorePtr CORE = GetCPCore();
@@ -50,6 +125,21 @@ static void CP_Graphics_DrawRectInternal(float x, float y, float w, float h, flo
 		break;
 	}
 
+	const float reach = CP_Graphics_StrokeReach(FALSE);
+	if (degrees != 0)
+	{
+		// rotated, the rectangle stays within the circle through its corner furthest from the pivot
+		float dx = fmaxf(fabsf(x - pointOfRotationX), fabsf(x + w - pointOfRotationX));
+		float dy = fmaxf(fabsf(y - pointOfRotationY), fabsf(y + h - pointOfRotationY));
+		float r = sqrtf(dx * dx + dy * dy);
+		if (CP_Cull_Rect(pointOfRotationX - r, pointOfRotationY - r, pointOfRotationX + r, pointOfRotationY + r, reach))
+			return;
+	}
+	else if (CP_Cull_Rect(x, y, x + w, y + h, reach))
+	{
+		return;
+	}
+
 	// rotation
 	if (degrees != 0)
 	{
@@ -85,6 +175,687 @@ static void CP_Graphics_DrawRectInternal(float x, float y, float w, float h, flo
 	}
 }
 
+static void CP_Batch_Flush(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (batch_count == 0)
+		return;
+
+	// send the colors added since the last flush
+	CP_Palette* palette = &palettes[palette_index];
+	if (palette_used > palette_uploaded)
+	{
+		int row0 = palette_uploaded / (CP_PALETTE_WIDTH / 2);
+		int row1 = (palette_used - 1) / (CP_PALETTE_WIDTH / 2);
+		nvgUpdateImageRegion(CORE->nvg, palette->image, 0, row0, CP_PALETTE_WIDTH, row1 - row0 + 1, palette->pixels);
+		palette_uploaded = palette_used;
+	}
+
+	NVGpaint paint;
+	memset(&paint, 0, sizeof(NVGpaint));
+	nvgTransformIdentity(paint.xform);
+	paint.extent[0] = (float)CP_PALETTE_WIDTH;
+	paint.extent[1] = (float)CP_PALETTE_HEIGHT;
+	paint.innerColor = paint.outerColor = nvgRGBA(255, 255, 255, 255);
+	paint.image = palette->image;
+	paint.textureFilterMode = NVG_TEXTURE_FILTER_LINEAR;
+	paint.textureWrapMode = NVG_TEXTURE_WRAP_CLAMP_EDGE;
+
+	nvgTriangles(CORE->nvg, paint, batch_verts, batch_count);
+	batch_count = 0;
+}
+
+// Prepares the shared batch state for the current transform and frame
+static void CP_Batch_Begin(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+
+	unsigned frame = CP_System_GetFrameCount();
+	if (frame != palette_frame)
+	{
+		palette_frame = frame;
+		palette_index = 0;
+		palette_used = 0;
+		palette_uploaded = 0;
+		palette_serial++;
+	}
+
+	// same scale estimate nanovg uses for its own fringe and tolerance
+	float xform[6];
+	nvgCurrentTransform(CORE->nvg, xform);
+	float scale = (sqrtf(xform[0] * xform[0] + xform[2] * xform[2]) + sqrtf(xform[1] * xform[1] + xform[3] * xform[3])) * 0.5f;
+	if (scale < 1e-6f)
+		scale = 1e-6f;
+
+	float ratio = CORE->pixel_ratio > 0 ? CORE->pixel_ratio : 1.0f;
+	batch_fringe = nvgCurrentShapeAntiAlias(CORE->nvg) ? (1.0f / ratio) / scale : 0;
+	batch_tolerance = (0.25f / ratio) / scale;
+	batch_count = 0;
+}
+
+static CP_BOOL CP_Batch_Reserve(int count)
+{
+	if (batch_count + count <= batch_capacity)
+		return TRUE;
+
+	int capacity = batch_capacity + batch_capacity / 2;
+	if (capacity < batch_count + count)
+		capacity = batch_count + count;
+	if (capacity < 1024)
+		capacity = 1024;
+
+	NVGvertex* verts = (NVGvertex*)realloc(batch_verts, capacity * sizeof(NVGvertex));
+	if (!verts)
+		return FALSE;
+
+	batch_verts = verts;
+	batch_capacity = capacity;
+	return TRUE;
+}
+
+static void CP_Batch_Vertex(float x, float y, float u, float v)
+{
+	NVGvertex* vertex = &batch_verts[batch_count++];
+	vertex->x = x;
+	vertex->y = y;
+	vertex->u = u;
+	vertex->v = v;
+}
+
+// Returns the palette entry for a color, reusing the cached entry when it is still valid
+static CP_BOOL CP_Batch_Color(CP_Color c, CP_BatchColor* entry)
+{
+	if (entry->serial == palette_serial && !memcmp(&entry->color, &c, sizeof(CP_Color)))
+		return TRUE;
+
+	// a full palette has to be drawn before moving on to the next one
+	if (palette_used == CP_PALETTE_COLORS)
+	{
+		CP_Batch_Flush();
+		palette_index++;
+		palette_used = 0;
+		palette_uploaded = 0;
+		palette_serial++;
+	}
+
+	if (palette_index >= palette_count)
+	{
+		CP_Palette* temp = (CP_Palette*)realloc(palettes, (palette_count + 1) * sizeof(CP_Palette));
+		if (!temp)
+			return FALSE;
+		palettes = temp;
+
+		CP_Palette* palette = &palettes[palette_count];
+		palette->pixels = (unsigned char*)calloc(CP_PALETTE_WIDTH * CP_PALETTE_HEIGHT, 4);
+		if (!palette->pixels)
+			return FALSE;
+		palette->image = nvgCreateImageRGBA(GetCPCore()->nvg, CP_PALETTE_WIDTH, CP_PALETTE_HEIGHT, 0, palette->pixels);
+		if (palette->image == 0)
+		{
+			free(palette->pixels);
+			return FALSE;
+		}
+		palette_count++;
+	}
+
+	int column = (palette_used % (CP_PALETTE_WIDTH / 2)) * 2;
+	int row = palette_used / (CP_PALETTE_WIDTH / 2);
+	unsigned char* texel = &palettes[palette_index].pixels[(row * CP_PALETTE_WIDTH + column) * 4];
+	texel[0] = texel[4] = c.r;
+	texel[1] = texel[5] = c.g;
+	texel[2] = texel[6] = c.b;
+	texel[3] = c.a;
+	texel[7] = 0;
+	palette_used++;
+
+	entry->u_inner = ((float)column + 0.5f) / (float)CP_PALETTE_WIDTH;
+	entry->u_outer = ((float)column + 1.5f) / (float)CP_PALETTE_WIDTH;
+	entry->v = ((float)row + 0.5f) / (float)CP_PALETTE_HEIGHT;
+	entry->serial = palette_serial;
+	entry->color = c;
+	return TRUE;
+}
+
+// Looks up a pair of colors so that both end up in the same palette
+static CP_BOOL CP_Batch_ColorPair(CP_Color a, CP_BatchColor* entryA, CP_Color b, CP_BatchColor* entryB)
+{
+	if (!CP_Batch_Color(a, entryA) || !CP_Batch_Color(b, entryB))
+		return FALSE;
+	if (entryA->serial != entryB->serial)
+		return CP_Batch_Color(a, entryA);
+	return TRUE;
+}
+
+static CP_Color CP_Batch_PaintColor(NVGpaint paint, float alpha)
+{
+	return CP_Color_Create((int)(paint.innerColor.r * 255.0f + 0.5f), (int)(paint.innerColor.g * 255.0f + 0.5f),
+		(int)(paint.innerColor.b * 255.0f + 0.5f), (int)(paint.innerColor.a * alpha * 255.0f + 0.5f));
+}
+
+// Thin strokes are widened to the fringe and faded instead, the same way nvgStroke does it
+static float CP_Batch_StrokeHalfWidth(float width, float* alpha)
+{
+	*alpha = 1.0f;
+	if (width < batch_fringe)
+	{
+		float a = CP_Math_ClampFloat(width / batch_fringe, 0.0f, 1.0f);
+		*alpha = a * a;
+		width = batch_fringe;
+	}
+	return width * 0.5f;
+}
+
+static int CP_Batch_CurveSegments(float radius, float angle)
+{
+	float da = acosf(radius / (radius + batch_tolerance)) * 2.0f;
+	int segments = da > 0 ? (int)ceilf(angle / da) : CP_BATCH_MAX_SEGMENTS;
+	return CP_Math_ClampInt(segments, 2, CP_BATCH_MAX_SEGMENTS);
+}
+
+// Outward facing unit normals of each edge (i, i + 1) and the miter direction at each point
+static void CP_Batch_Normals(const CP_Vector* points, int count, CP_Vector* normals, CP_Vector* miters)
+{
+	float area = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		const CP_Vector* p0 = &points[i];
+		const CP_Vector* p1 = &points[(i + 1) % count];
+		area += p0->x * p1->y - p1->x * p0->y;
+	}
+	float side = area > 0 ? 1.0f : -1.0f;
+
+	for (int i = 0; i < count; ++i)
+	{
+		const CP_Vector* p0 = &points[i];
+		const CP_Vector* p1 = &points[(i + 1) % count];
+		float dx = p1->x - p0->x;
+		float dy = p1->y - p0->y;
+		float length = sqrtf(dx * dx + dy * dy);
+		if (length > 1e-6f)
+		{
+			dx /= length;
+			dy /= length;
+		}
+		normals[i].x = dy * side;
+		normals[i].y = -dx * side;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		const CP_Vector* n0 = &normals[(i + count - 1) % count];
+		const CP_Vector* n1 = &normals[i];
+		float mx = (n0->x + n1->x) * 0.5f;
+		float my = (n0->y + n1->y) * 0.5f;
+		float length2 = mx * mx + my * my;
+		float scale = length2 > 1e-6f ? 1.0f / length2 : 0;
+		if (scale > 600.0f)
+			scale = 600.0f;
+		miters[i].x = mx * scale;
+		miters[i].y = my * scale;
+	}
+}
+
+// Fills a convex polygon, the antialiased fringe straddles the outline like nvgFill's does
+static CP_BOOL CP_Batch_ConvexFill(const CP_Vector* points, int count, const CP_BatchColor* color)
+{
+	CP_Vector normals[CP_BATCH_MAX_POINTS];
+	CP_Vector miters[CP_BATCH_MAX_POINTS];
+	if (count < 3 || count > CP_BATCH_MAX_POINTS)
+		return FALSE;
+
+	float h = batch_fringe * 0.5f;
+	if (!CP_Batch_Reserve(3 * (count - 2) + (h > 0 ? 6 * count : 0)))
+		return FALSE;
+
+	CP_Batch_Normals(points, count, normals, miters);
+
+	float x0 = points[0].x - miters[0].x * h;
+	float y0 = points[0].y - miters[0].y * h;
+	for (int i = 1; i < count - 1; ++i)
+	{
+		CP_Batch_Vertex(x0, y0, color->u_inner, color->v);
+		CP_Batch_Vertex(points[i].x - miters[i].x * h, points[i].y - miters[i].y * h, color->u_inner, color->v);
+		CP_Batch_Vertex(points[i + 1].x - miters[i + 1].x * h, points[i + 1].y - miters[i + 1].y * h, color->u_inner, color->v);
+	}
+
+	if (h > 0)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			int j = (i + 1) % count;
+			float ix0 = points[i].x - miters[i].x * h, iy0 = points[i].y - miters[i].y * h;
+			float ox0 = points[i].x + miters[i].x * h, oy0 = points[i].y + miters[i].y * h;
+			float ix1 = points[j].x - miters[j].x * h, iy1 = points[j].y - miters[j].y * h;
+			float ox1 = points[j].x + miters[j].x * h, oy1 = points[j].y + miters[j].y * h;
+			CP_Batch_Vertex(ix0, iy0, color->u_inner, color->v);
+			CP_Batch_Vertex(ox0, oy0, color->u_outer, color->v);
+			CP_Batch_Vertex(ox1, oy1, color->u_outer, color->v);
+			CP_Batch_Vertex(ix0, iy0, color->u_inner, color->v);
+			CP_Batch_Vertex(ox1, oy1, color->u_outer, color->v);
+			CP_Batch_Vertex(ix1, iy1, color->u_inner, color->v);
+		}
+	}
+	return TRUE;
+}
+
+// Emits one quad of a stroke band between the offsets d0 and d1 (inner to outer) along the directions
+static void CP_Batch_BandQuad(const CP_Vector* p0, const CP_Vector* in0, const CP_Vector* out0,
+	const CP_Vector* p1, const CP_Vector* in1, const CP_Vector* out1,
+	float d0, float d1, float u0, float u1, float v)
+{
+	float ax = p0->x + in0->x * d0, ay = p0->y + in0->y * d0;
+	float bx = p0->x + out0->x * d1, by = p0->y + out0->y * d1;
+	float cx = p1->x + out1->x * d1, cy = p1->y + out1->y * d1;
+	float dx = p1->x + in1->x * d0, dy = p1->y + in1->y * d0;
+	CP_Batch_Vertex(ax, ay, u0, v);
+	CP_Batch_Vertex(bx, by, u1, v);
+	CP_Batch_Vertex(cx, cy, u1, v);
+	CP_Batch_Vertex(ax, ay, u0, v);
+	CP_Batch_Vertex(cx, cy, u1, v);
+	CP_Batch_Vertex(dx, dy, u0, v);
+}
+
+// Strokes the outline of a closed convex polygon with the current line join
+static CP_BOOL CP_Batch_ConvexStroke(const CP_Vector* points, int count, float halfWidth, int lineJoin, float miterLimit, const CP_BatchColor* color)
+{
+	CP_Vector normals[CP_BATCH_MAX_POINTS];
+	CP_Vector miters[CP_BATCH_MAX_POINTS];
+	CP_Vector base[CP_BATCH_MAX_POINTS];
+	CP_Vector inner[CP_BATCH_MAX_POINTS];
+	CP_Vector outer[CP_BATCH_MAX_POINTS];
+	if (count < 3 || count > CP_BATCH_MAX_POINTS)
+		return FALSE;
+
+	CP_Batch_Normals(points, count, normals, miters);
+
+	// the outside of each corner is mitered, beveled or rounded, the inside is always mitered
+	int budget = CP_BATCH_MAX_POINTS / count - 1;
+	int pairs = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		const CP_Vector* n0 = &normals[(i + count - 1) % count];
+		const CP_Vector* n1 = &normals[i];
+		const CP_Vector* m = &miters[i];
+		float length2 = m->x * m->x + m->y * m->y;
+		int steps = 0;
+
+		if (lineJoin == NVG_ROUND)
+		{
+			float cross = n0->x * n1->y - n0->y * n1->x;
+			float angle = fabsf(atan2f(cross, n0->x * n1->x + n0->y * n1->y));
+			steps = angle > 1e-3f ? CP_Batch_CurveSegments(halfWidth, angle) : 0;
+			if (steps > budget)
+				steps = budget;
+		}
+		else if (lineJoin == NVG_BEVEL || length2 > miterLimit * miterLimit)
+		{
+			steps = 1;
+		}
+
+		if (steps == 0 || length2 < 1e-6f)
+		{
+			base[pairs] = points[i];
+			inner[pairs].x = -m->x;
+			inner[pairs].y = -m->y;
+			outer[pairs] = *m;
+			pairs++;
+			continue;
+		}
+
+		// rotate from the previous edge normal to the next one
+		float a0 = atan2f(n0->y, n0->x);
+		float delta = atan2f(n0->x * n1->y - n0->y * n1->x, n0->x * n1->x + n0->y * n1->y);
+		for (int s = 0; s <= steps; ++s)
+		{
+			float a = a0 + delta * (float)s / (float)steps;
+			base[pairs] = points[i];
+			inner[pairs].x = -m->x;
+			inner[pairs].y = -m->y;
+			outer[pairs].x = cosf(a);
+			outer[pairs].y = sinf(a);
+			pairs++;
+		}
+	}
+
+	float h = batch_fringe * 0.5f;
+	if (!CP_Batch_Reserve(pairs * (h > 0 ? 18 : 6)))
+		return FALSE;
+
+	for (int i = 0; i < pairs; ++i)
+	{
+		int j = (i + 1) % pairs;
+		// core of the band, inner edge is at -(halfWidth - h) along the inner direction
+		CP_Batch_BandQuad(&base[i], &inner[i], &outer[i], &base[j], &inner[j], &outer[j], halfWidth - h, halfWidth - h, color->u_inner, color->u_inner, color->v);
+		if (h > 0)
+		{
+			CP_Batch_BandQuad(&base[i], &outer[i], &outer[i], &base[j], &outer[j], &outer[j], halfWidth - h, halfWidth + h, color->u_inner, color->u_outer, color->v);
+			CP_Batch_BandQuad(&base[i], &inner[i], &inner[i], &base[j], &inner[j], &inner[j], halfWidth - h, halfWidth + h, color->u_inner, color->u_outer, color->v);
+		}
+	}
+	return TRUE;
+}
+
+static int CP_Batch_CirclePoints(float x, float y, float r, CP_Vector* points)
+{
+	int count = CP_Batch_CurveSegments(r, 2.0f * (float)M_PI);
+	if (count < CP_BATCH_MIN_SEGMENTS)
+		count = CP_BATCH_MIN_SEGMENTS;
+	for (int i = 0; i < count; ++i)
+	{
+		float a = 2.0f * (float)M_PI * (float)i / (float)count;
+		points[i].x = x + cosf(a) * r;
+		points[i].y = y + sinf(a) * r;
+	}
+	return count;
+}
+
+// Outline of a stroked line segment including its caps, returns 0 if nothing should be drawn
+static int CP_Batch_LinePoints(CP_Vector p0, CP_Vector p1, float halfWidth, int lineCap, CP_Vector* points)
+{
+	float dx = p1.x - p0.x;
+	float dy = p1.y - p0.y;
+	float length = sqrtf(dx * dx + dy * dy);
+	if (length > 1e-6f)
+	{
+		dx /= length;
+		dy /= length;
+	}
+	else if (lineCap == NVG_BUTT)
+	{
+		return 0;
+	}
+	else
+	{
+		dx = 1.0f;
+		dy = 0;
+	}
+
+	float nx = -dy * halfWidth;
+	float ny = dx * halfWidth;
+
+	if (lineCap == NVG_ROUND)
+	{
+		int steps = CP_Batch_CurveSegments(halfWidth, (float)M_PI);
+		if (steps > CP_BATCH_MAX_SEGMENTS - 1)
+			steps = CP_BATCH_MAX_SEGMENTS - 1;
+		int count = 0;
+		float a0 = atan2f(ny, nx);
+		for (int s = 0; s <= steps; ++s)
+		{
+			float a = a0 - (float)M_PI * (float)s / (float)steps;
+			points[count].x = p1.x + cosf(a) * halfWidth;
+			points[count].y = p1.y + sinf(a) * halfWidth;
+			count++;
+		}
+		for (int s = 0; s <= steps; ++s)
+		{
+			float a = a0 + (float)M_PI - (float)M_PI * (float)s / (float)steps;
+			points[count].x = p0.x + cosf(a) * halfWidth;
+			points[count].y = p0.y + sinf(a) * halfWidth;
+			count++;
+		}
+		return count;
+	}
+
+	if (lineCap == NVG_SQUARE)
+	{
+		p0.x -= dx * halfWidth;
+		p0.y -= dy * halfWidth;
+		p1.x += dx * halfWidth;
+		p1.y += dy * halfWidth;
+	}
+
+	points[0].x = p0.x + nx;
+	points[0].y = p0.y + ny;
+	points[1].x = p1.x + nx;
+	points[1].y = p1.y + ny;
+	points[2].x = p1.x - nx;
+	points[2].y = p1.y - ny;
+	points[3].x = p0.x - nx;
+	points[3].y = p0.y - ny;
+	return 4;
+}
+
+// Fills the 1x1 square of a point, the fringe is kept within the point so tiny points fade out
+static void CP_Batch_PointQuad(float x, float y, const CP_BatchColor* color)
+{
+	float h = fminf(batch_fringe * 0.5f, 0.5f);
+	CP_Vector inner[4] = { { x + h, y + h }, { x + 1.0f - h, y + h }, { x + 1.0f - h, y + 1.0f - h }, { x + h, y + 1.0f - h } };
+
+	CP_Batch_Vertex(inner[0].x, inner[0].y, color->u_inner, color->v);
+	CP_Batch_Vertex(inner[1].x, inner[1].y, color->u_inner, color->v);
+	CP_Batch_Vertex(inner[2].x, inner[2].y, color->u_inner, color->v);
+	CP_Batch_Vertex(inner[0].x, inner[0].y, color->u_inner, color->v);
+	CP_Batch_Vertex(inner[2].x, inner[2].y, color->u_inner, color->v);
+	CP_Batch_Vertex(inner[3].x, inner[3].y, color->u_inner, color->v);
+
+	if (h <= 0)
+		return;
+
+	CP_Vector outer[4] = { { x - h, y - h }, { x + 1.0f + h, y - h }, { x + 1.0f + h, y + 1.0f + h }, { x - h, y + 1.0f + h } };
+	for (int i = 0; i < 4; ++i)
+	{
+		int j = (i + 1) & 3;
+		CP_Batch_Vertex(inner[i].x, inner[i].y, color->u_inner, color->v);
+		CP_Batch_Vertex(outer[i].x, outer[i].y, color->u_outer, color->v);
+		CP_Batch_Vertex(outer[j].x, outer[j].y, color->u_outer, color->v);
+		CP_Batch_Vertex(inner[i].x, inner[i].y, color->u_inner, color->v);
+		CP_Batch_Vertex(outer[j].x, outer[j].y, color->u_outer, color->v);
+		CP_Batch_Vertex(inner[j].x, inner[j].y, color->u_inner, color->v);
+	}
+}
+
+// A polyline stroke is built as one strip of cross sections. Each cross section is a point on the
+// line with the directions to its left and right edges, scaled so that halfWidth along them lands
+// on the edge. Joins and round caps fan out as several cross sections around the same point.
+typedef struct CP_BatchStrip
+{
+	CP_Vector base;
+	CP_Vector left;
+	CP_Vector right;
+	CP_Vector firstBase;
+	CP_Vector firstLeft;
+	CP_Vector firstRight;
+	CP_BOOL started;
+	float halfWidth;
+	const CP_BatchColor* color;
+} CP_BatchStrip;
+
+static CP_Vector* polyline_points = NULL;
+static int polyline_capacity = 0;
+
+// Joins the previous cross section to this one with a core band and two antialiased fringes
+static CP_BOOL CP_Batch_StripSection(CP_BatchStrip* strip, CP_Vector base, CP_Vector left, CP_Vector right)
+{
+	float h = batch_fringe * 0.5f;
+	if (!CP_Batch_Reserve(h > 0 ? 18 : 6))
+		return FALSE;
+
+	if (strip->started)
+	{
+		const CP_BatchColor* c = strip->color;
+		float hw = strip->halfWidth;
+		CP_Batch_BandQuad(&strip->base, &strip->right, &strip->left, &base, &right, &left, hw - h, hw - h, c->u_inner, c->u_inner, c->v);
+		if (h > 0)
+		{
+			CP_Batch_BandQuad(&strip->base, &strip->left, &strip->left, &base, &left, &left, hw - h, hw + h, c->u_inner, c->u_outer, c->v);
+			CP_Batch_BandQuad(&strip->base, &strip->right, &strip->right, &base, &right, &right, hw - h, hw + h, c->u_inner, c->u_outer, c->v);
+		}
+	}
+	else
+	{
+		strip->firstBase = base;
+		strip->firstLeft = left;
+		strip->firstRight = right;
+		strip->started = TRUE;
+	}
+
+	strip->base = base;
+	strip->left = left;
+	strip->right = right;
+	return TRUE;
+}
+
+// Emits the cross sections of the join at p between the unit directions d0 and d1
+static CP_BOOL CP_Batch_StripJoin(CP_BatchStrip* strip, CP_Vector p, CP_Vector d0, float length0, CP_Vector d1, float length1, int lineJoin, float miterLimit)
+{
+	CP_Vector n0 = { -d0.y, d0.x };
+	CP_Vector n1 = { -d1.y, d1.x };
+	float cross = d0.x * d1.y - d0.y * d1.x;
+	float dot = d0.x * d1.x + d0.y * d1.y;
+
+	// miter direction, same clamp as CP_Batch_Normals
+	CP_Vector m = { (n0.x + n1.x) * 0.5f, (n0.y + n1.y) * 0.5f };
+	float length2 = m.x * m.x + m.y * m.y;
+	float scale = length2 > 1e-6f ? 1.0f / length2 : 0;
+	if (scale > 600.0f)
+		scale = 600.0f;
+	m.x *= scale;
+	m.y *= scale;
+	length2 = m.x * m.x + m.y * m.y;
+
+	if (fabsf(cross) < 1e-6f && dot > 0)
+		return CP_Batch_StripSection(strip, p, m, CP_Vector_Negate(m));
+
+	// the inside of a sharp turn is mitered, but never further than the shorter segment reaches
+	CP_Vector inner = m;
+	float limit = fmaxf(fminf(length0, length1) / strip->halfWidth, 1.01f);
+	if (length2 > limit * limit)
+	{
+		float shrink = limit / sqrtf(length2);
+		inner.x *= shrink;
+		inner.y *= shrink;
+	}
+
+	int steps = 0;
+	if (lineJoin == NVG_ROUND)
+		steps = CP_Batch_CurveSegments(strip->halfWidth, fabsf(atan2f(cross, dot)));
+	else if (lineJoin == NVG_BEVEL || length2 > miterLimit * miterLimit)
+		steps = 1;
+
+	// turning left puts the outside of the corner on the right
+	CP_BOOL outsideRight = cross > 0;
+	if (steps == 0)
+	{
+		if (outsideRight)
+			return CP_Batch_StripSection(strip, p, inner, CP_Vector_Negate(m));
+		return CP_Batch_StripSection(strip, p, m, CP_Vector_Negate(inner));
+	}
+
+	float side = outsideRight ? -1.0f : 1.0f;
+	float a0 = atan2f(n0.y * side, n0.x * side);
+	float delta = atan2f(cross, dot);
+	for (int s = 0; s <= steps; ++s)
+	{
+		float a = a0 + delta * (float)s / (float)steps;
+		CP_Vector outer = { cosf(a), sinf(a) };
+		CP_BOOL added = outsideRight ? CP_Batch_StripSection(strip, p, inner, outer)
+			: CP_Batch_StripSection(strip, p, outer, CP_Vector_Negate(inner));
+		if (!added)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+// Emits the cap at the end p of a polyline, d points out of the line
+static CP_BOOL CP_Batch_StripCap(CP_BatchStrip* strip, CP_Vector p, CP_Vector d, int lineCap, CP_BOOL start)
+{
+	float hw = strip->halfWidth;
+	float h = batch_fringe * 0.5f;
+	// left of the line, which runs against d at the start and along it at the end
+	CP_Vector n = { -d.y, d.x };
+	if (start)
+		n = CP_Vector_Negate(n);
+
+	if (lineCap == NVG_ROUND)
+	{
+		// half a circle, swept from the tip to the side or from the side to the tip
+		int steps = CP_Batch_CurveSegments(hw, (float)M_PI * 0.5f);
+		for (int s = 0; s <= steps; ++s)
+		{
+			float t = (float)(start ? s : steps - s) / (float)steps;
+			float c = cosf(t * (float)M_PI * 0.5f);
+			float sn = sinf(t * (float)M_PI * 0.5f);
+			CP_Vector left = { d.x * c + n.x * sn, d.y * c + n.y * sn };
+			CP_Vector right = { d.x * c - n.x * sn, d.y * c - n.y * sn };
+			if (!CP_Batch_StripSection(strip, p, left, right))
+				return FALSE;
+		}
+		return TRUE;
+	}
+
+	if (lineCap == NVG_SQUARE)
+	{
+		p.x += d.x * hw;
+		p.y += d.y * hw;
+	}
+
+	// the flat end gets its own fringe, the strip stops short of it by half the fringe
+	CP_Vector end = { p.x - d.x * h, p.y - d.y * h };
+	if (h > 0)
+	{
+		if (!CP_Batch_Reserve(6))
+			return FALSE;
+		const CP_BatchColor* c = strip->color;
+		float ix0 = end.x + n.x * (hw - h), iy0 = end.y + n.y * (hw - h);
+		float ix1 = end.x - n.x * (hw - h), iy1 = end.y - n.y * (hw - h);
+		float ox0 = p.x + d.x * h + n.x * (hw + h), oy0 = p.y + d.y * h + n.y * (hw + h);
+		float ox1 = p.x + d.x * h - n.x * (hw + h), oy1 = p.y + d.y * h - n.y * (hw + h);
+		CP_Batch_Vertex(ix0, iy0, c->u_inner, c->v);
+		CP_Batch_Vertex(ox0, oy0, c->u_outer, c->v);
+		CP_Batch_Vertex(ox1, oy1, c->u_outer, c->v);
+		CP_Batch_Vertex(ix0, iy0, c->u_inner, c->v);
+		CP_Batch_Vertex(ox1, oy1, c->u_outer, c->v);
+		CP_Batch_Vertex(ix1, iy1, c->u_inner, c->v);
+	}
+	return CP_Batch_StripSection(strip, end, n, CP_Vector_Negate(n));
+}
+
+// Copies the points of a polyline without repeats, returns how many are left
+static int CP_Batch_PolylinePoints(const CP_Vector* points, int count, CP_BOOL closed)
+{
+	if (count > polyline_capacity)
+	{
+		CP_Vector* temp = (CP_Vector*)realloc(polyline_points, count * sizeof(CP_Vector));
+		if (!temp)
+			return 0;
+		polyline_points = temp;
+		polyline_capacity = count;
+	}
+
+	int unique = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		if (unique > 0 && fabsf(points[i].x - polyline_points[unique - 1].x) < 1e-6f && fabsf(points[i].y - polyline_points[unique - 1].y) < 1e-6f)
+			continue;
+		polyline_points[unique++] = points[i];
+	}
+	if (closed && unique > 1 && fabsf(polyline_points[0].x - polyline_points[unique - 1].x) < 1e-6f && fabsf(polyline_points[0].y - polyline_points[unique - 1].y) < 1e-6f)
+		unique--;
+	return unique;
+}
+
+// Unit direction from a to b, the length goes to length
+static CP_Vector CP_Batch_Direction(CP_Vector a, CP_Vector b, float* length)
+{
+	CP_Vector d = { b.x - a.x, b.y - a.y };
+	*length = sqrtf(d.x * d.x + d.y * d.y);
+	if (*length > 1e-6f)
+	{
+		d.x /= *length;
+		d.y /= *length;
+	}
+	return d;
+}
+
+// Clears the bound GL framebuffer, runs where the GL context is current
+static void CP_Graphics_ClearTarget(void* data)
+{
+	const CP_Color* c = (const CP_Color*)data;
+	glClearColor(c->r / 255.0f, c->g / 255.0f, c->b / 255.0f, c->a / 255.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
 //------------------------------------------------------------------------------
 // Library Functions:
 //------------------------------------------------------------------------------
@@ -92,8 +863,12 @@ static void CP_Graphics_DrawRectInternal(float x, float y, float w, float h, flo
 CP_API void CP_Graphics_ClearBackground(CP_Color c)
 {
 	// Set the background color
-	glClearColor(c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+	if (GetCPCore()->isHeadless)
+	{
+		nvgswClear(GetCPCore()->nvg, nvgRGBA(c.r, c.g, c.b, c.a));
+		return;
+	}
+	CP_Render_Call(CP_Graphics_ClearTarget, &c, sizeof(c));
 }
 
 CP_API void CP_Graphics_DrawPoint(float x, float y)
@@ -102,7 +877,7 @@ CP_API void CP_Graphics_DrawPoint(float x, float y)
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
 	// Point only has fill, no stroke
-	if (DI->fill)
+	if (DI->fill && !CP_Cull_Rect(x, y, x + 1.0f, y + 1.0f, 0))
 	{
 		nvgBeginPath(CORE->nvg);
 		nvgRect(CORE->nvg, x, y, 1.0f, 1.0f);
@@ -116,7 +891,7 @@ CP_API void CP_Graphics_DrawLine(float x1, float y1, float x2, float y2)
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
 	// Line stroke
-	if (DI->stroke)
+	if (DI->stroke && !CP_Cull_Rect(x1, y1, x2, y2, CP_Graphics_LineReach(nvgCurrentStrokeWidth(CORE->nvg) * 0.5f)))
 	{
 		nvgBeginPath(CORE->nvg);
 		nvgMoveTo(CORE->nvg, x1, y1);
@@ -130,6 +905,16 @@ CP_API void CP_Graphics_DrawLineAdvanced(float x1, float y1, float x2, float y2,
 	CP_CorePtr CORE = GetCPCore();
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
+	if (!DI->stroke)
+		return;
+
+	// rotated around its middle, the line stays within the circle through its ends
+	float cx = (x1 + x2) * 0.5f;
+	float cy = (y1 + y2) * 0.5f;
+	float r = CP_Math_Distance(x1, y1, x2, y2) * 0.5f;
+	if (CP_Cull_Rect(cx - r, cy - r, cx + r, cy + r, CP_Graphics_LineReach(nvgCurrentStrokeWidth(CORE->nvg) * 0.5f)))
+		return;
+
 	// rotation
 	nvgSave(CORE->nvg);
 	nvgTranslate(CORE->nvg, ((x1 + x2) / 2.0f), ((y1 + y2) / 2.0f));
@@ -184,6 +969,9 @@ CP_API void CP_Graphics_DrawEllipse(float x, float y, float w, float h)
 		break;
 	}
 
+	if (CP_Cull_Rect(x - rw, y - rh, x + rw, y + rh, CP_Graphics_StrokeReach(FALSE)))
+		return;
+
 	// Ellipse path
 	nvgBeginPath(CORE->nvg);
 	nvgEllipse(CORE->nvg, x, y, rw, rh);
@@ -221,6 +1009,10 @@ CP_API void CP_Graphics_DrawTriangle(float x1, float y1, float x2, float y2, flo
 	CP_CorePtr CORE = GetCPCore();
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
+	if (CP_Cull_Rect(fminf(x1, fminf(x2, x3)), fminf(y1, fminf(y2, y3)),
+		fmaxf(x1, fmaxf(x2, x3)), fmaxf(y1, fmaxf(y2, y3)), CP_Graphics_StrokeReach(FALSE)))
+		return;
+
 	// Triangle path
 	nvgBeginPath(CORE->nvg);
 	nvgMoveTo(CORE->nvg, x1, y1);
@@ -266,6 +1058,10 @@ CP_API void CP_Graphics_DrawQuad(float x1, float y1, float x2, float y2, float x
 	CP_CorePtr CORE = GetCPCore();
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
+	if (CP_Cull_Rect(fminf(fminf(x1, x2), fminf(x3, x4)), fminf(fminf(y1, y2), fminf(y3, y4)),
+		fmaxf(fmaxf(x1, x2), fmaxf(x3, x4)), fmaxf(fmaxf(y1, y2), fmaxf(y3, y4)), CP_Graphics_StrokeReach(FALSE)))
+		return;
+
 	// Quad path
 	nvgBeginPath(CORE->nvg);
 	nvgMoveTo(CORE->nvg, x1, y1);
@@ -299,6 +1095,279 @@ CP_API void CP_Graphics_DrawQuadAdvanced(float x1, float y1, float x2, float y2,
 	nvgRestore(CORE->nvg);
 }
 
+CP_API void CP_Graphics_DrawRects(const CP_Vector* positions, const CP_Vector* sizes, const CP_Color* colors, int count)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+	if (!CORE || !CORE->nvg || !DI || !positions || !sizes || count <= 0)
+		return;
+	if (!DI->fill && !DI->stroke)
+		return;
+
+	CP_Batch_Begin();
+
+	float strokeAlpha = 1.0f;
+	float halfWidth = CP_Batch_StrokeHalfWidth(nvgCurrentStrokeWidth(CORE->nvg), &strokeAlpha);
+	int lineJoin = nvgCurrentLineJoin(CORE->nvg);
+	float miterLimit = nvgCurrentMiterLimit(CORE->nvg);
+	CP_Color fillColor = CP_Batch_PaintColor(nvgCurrentFillPaint(CORE->nvg), 1.0f);
+	CP_Color strokeColor = CP_Batch_PaintColor(nvgCurrentStrokePaint(CORE->nvg), strokeAlpha);
+	CP_BatchColor fill = { 0 };
+	CP_BatchColor stroke = { 0 };
+	const float reach = !DI->stroke ? 0 : CP_Graphics_StrokeReachOf(halfWidth, NVG_BUTT, lineJoin, miterLimit);
+
+	for (int i = 0; i < count; ++i)
+	{
+		float x = positions[i].x;
+		float y = positions[i].y;
+		float w = sizes[i].x;
+		float h = sizes[i].y;
+		if (DI->rect_mode == CP_POSITION_CENTER)
+		{
+			x -= w * 0.5f;
+			y -= h * 0.5f;
+		}
+		if (CP_Cull_Rect(x, y, x + w, y + h, reach))
+			continue;
+
+		CP_Vector corners[4];
+		corners[0] = CP_Vector_Set(x, y);
+		corners[1] = CP_Vector_Set(x + w, y);
+		corners[2] = CP_Vector_Set(x + w, y + h);
+		corners[3] = CP_Vector_Set(x, y + h);
+		CP_Color color = colors ? colors[i] : fillColor;
+
+		if (DI->fill && DI->stroke)
+		{
+			if (!CP_Batch_ColorPair(color, &fill, strokeColor, &stroke))
+				break;
+		}
+		else if (!CP_Batch_Color(DI->fill ? color : strokeColor, DI->fill ? &fill : &stroke))
+		{
+			break;
+		}
+
+		if (DI->fill)
+			CP_Batch_ConvexFill(corners, 4, &fill);
+		if (DI->stroke)
+			CP_Batch_ConvexStroke(corners, 4, halfWidth, lineJoin, miterLimit, &stroke);
+	}
+
+	CP_Batch_Flush();
+}
+
+CP_API void CP_Graphics_DrawCircles(const CP_Vector* positions, const float* diameters, const CP_Color* colors, int count)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+	if (!CORE || !CORE->nvg || !DI || !positions || !diameters || count <= 0)
+		return;
+	if (!DI->fill && !DI->stroke)
+		return;
+
+	CP_Batch_Begin();
+
+	float strokeAlpha = 1.0f;
+	float halfWidth = CP_Batch_StrokeHalfWidth(nvgCurrentStrokeWidth(CORE->nvg), &strokeAlpha);
+	float miterLimit = nvgCurrentMiterLimit(CORE->nvg);
+	CP_Color fillColor = CP_Batch_PaintColor(nvgCurrentFillPaint(CORE->nvg), 1.0f);
+	CP_Color strokeColor = CP_Batch_PaintColor(nvgCurrentStrokePaint(CORE->nvg), strokeAlpha);
+	CP_BatchColor fill = { 0 };
+	CP_BatchColor stroke = { 0 };
+	CP_Vector points[CP_BATCH_MAX_POINTS];
+
+	for (int i = 0; i < count; ++i)
+	{
+		float r = fabsf(diameters[i]) * 0.5f;
+		float x = positions[i].x;
+		float y = positions[i].y;
+		if (DI->ellipse_mode == CP_POSITION_CORNER)
+		{
+			x += r;
+			y += r;
+		}
+		// the corners of the tessellated stroke stay well within twice its half width
+		if (r <= 0 || CP_Cull_Rect(x - r, y - r, x + r, y + r, DI->stroke ? halfWidth * 2.0f : 0))
+			continue;
+
+		CP_Color color = colors ? colors[i] : fillColor;
+
+		if (DI->fill && DI->stroke)
+		{
+			if (!CP_Batch_ColorPair(color, &fill, strokeColor, &stroke))
+				break;
+		}
+		else if (!CP_Batch_Color(DI->fill ? color : strokeColor, DI->fill ? &fill : &stroke))
+		{
+			break;
+		}
+
+		int pointCount = CP_Batch_CirclePoints(x, y, r, points);
+		if (DI->fill)
+			CP_Batch_ConvexFill(points, pointCount, &fill);
+		// a circle is smooth, so a miter join is always right
+		if (DI->stroke)
+			CP_Batch_ConvexStroke(points, pointCount, halfWidth, NVG_MITER, miterLimit, &stroke);
+	}
+
+	CP_Batch_Flush();
+}
+
+CP_API void CP_Graphics_DrawLines(const CP_Vector* starts, const CP_Vector* ends, const CP_Color* colors, int count)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+	if (!CORE || !CORE->nvg || !DI || !starts || !ends || count <= 0)
+		return;
+
+	// lines only have a stroke, the colors replace the stroke color
+	if (!DI->stroke)
+		return;
+
+	CP_Batch_Begin();
+
+	float strokeAlpha = 1.0f;
+	float halfWidth = CP_Batch_StrokeHalfWidth(nvgCurrentStrokeWidth(CORE->nvg), &strokeAlpha);
+	int lineCap = nvgCurrentLineCap(CORE->nvg);
+	CP_Color strokeColor = CP_Batch_PaintColor(nvgCurrentStrokePaint(CORE->nvg), strokeAlpha);
+	CP_BatchColor stroke = { 0 };
+	CP_Vector points[CP_BATCH_MAX_POINTS];
+	const float reach = CP_Graphics_LineReach(halfWidth);
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (CP_Cull_Rect(starts[i].x, starts[i].y, ends[i].x, ends[i].y, reach))
+			continue;
+
+		int pointCount = CP_Batch_LinePoints(starts[i], ends[i], halfWidth, lineCap, points);
+		if (pointCount == 0)
+			continue;
+
+		CP_Color color = strokeColor;
+		if (colors)
+		{
+			color = colors[i];
+			color.a = (unsigned char)(color.a * strokeAlpha + 0.5f);
+		}
+		if (!CP_Batch_Color(color, &stroke))
+			break;
+
+		CP_Batch_ConvexFill(points, pointCount, &stroke);
+	}
+
+	CP_Batch_Flush();
+}
+
+CP_API void CP_Graphics_DrawPoints(const CP_Vector* points, int count)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+	if (!CORE || !CORE->nvg || !DI || !points || count <= 0)
+		return;
+
+	// points only have a fill, like CP_Graphics_DrawPoint
+	if (!DI->fill)
+		return;
+
+	CP_Batch_Begin();
+
+	CP_BatchColor fill = { 0 };
+	if (!CP_Batch_Color(CP_Batch_PaintColor(nvgCurrentFillPaint(CORE->nvg), 1.0f), &fill))
+		return;
+
+	const int verticesPerPoint = batch_fringe > 0 ? 30 : 6;
+	for (int i = 0; i < count; ++i)
+	{
+		float x = points[i].x;
+		float y = points[i].y;
+		if (CP_Cull_Rect(x, y, x + 1.0f, y + 1.0f, 0))
+			continue;
+		if (!CP_Batch_Reserve(verticesPerPoint))
+			break;
+		CP_Batch_PointQuad(x, y, &fill);
+	}
+
+	CP_Batch_Flush();
+}
+
+CP_API void CP_Graphics_DrawPolyline(const CP_Vector* points, int count, CP_BOOL closed)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+	if (!CORE || !CORE->nvg || !DI || !points || count < 2)
+		return;
+
+	// polylines only have a stroke, like lines
+	if (!DI->stroke)
+		return;
+
+	CP_Batch_Begin();
+
+	float strokeAlpha = 1.0f;
+	float halfWidth = CP_Batch_StrokeHalfWidth(nvgCurrentStrokeWidth(CORE->nvg), &strokeAlpha);
+	int lineCap = nvgCurrentLineCap(CORE->nvg);
+	int lineJoin = nvgCurrentLineJoin(CORE->nvg);
+	float miterLimit = nvgCurrentMiterLimit(CORE->nvg);
+
+	count = CP_Batch_PolylinePoints(points, count, closed);
+	if (count < 2)
+		return;
+	if (count < 3)
+		closed = FALSE;
+
+	float bounds[4] = { polyline_points[0].x, polyline_points[0].y, polyline_points[0].x, polyline_points[0].y };
+	for (int i = 1; i < count; ++i)
+	{
+		bounds[0] = fminf(bounds[0], polyline_points[i].x);
+		bounds[1] = fminf(bounds[1], polyline_points[i].y);
+		bounds[2] = fmaxf(bounds[2], polyline_points[i].x);
+		bounds[3] = fmaxf(bounds[3], polyline_points[i].y);
+	}
+	if (CP_Cull_Rect(bounds[0], bounds[1], bounds[2], bounds[3], CP_Graphics_StrokeReachOf(halfWidth, closed ? NVG_BUTT : lineCap, lineJoin, miterLimit)))
+		return;
+
+	CP_BatchColor stroke = { 0 };
+	if (!CP_Batch_Color(CP_Batch_PaintColor(nvgCurrentStrokePaint(CORE->nvg), strokeAlpha), &stroke))
+		return;
+
+	CP_BatchStrip strip;
+	memset(&strip, 0, sizeof(CP_BatchStrip));
+	strip.halfWidth = halfWidth;
+	strip.color = &stroke;
+
+	// every point of a closed polyline is a join, an open one has a cap at each end instead
+	const CP_Vector* p = polyline_points;
+	float length0, length1;
+	CP_Vector d0 = CP_Batch_Direction(closed ? p[count - 1] : p[0], closed ? p[0] : p[1], &length0);
+	CP_BOOL ok = closed ? TRUE : CP_Batch_StripCap(&strip, p[0], CP_Vector_Negate(d0), lineCap, TRUE);
+	for (int i = closed ? 0 : 1; ok && i < (closed ? count : count - 1); ++i)
+	{
+		CP_Vector d1 = CP_Batch_Direction(p[i], p[(i + 1) % count], &length1);
+		ok = CP_Batch_StripJoin(&strip, p[i], d0, length0, d1, length1, lineJoin, miterLimit);
+		d0 = d1;
+		length0 = length1;
+	}
+	if (ok && closed)
+		CP_Batch_StripSection(&strip, strip.firstBase, strip.firstLeft, strip.firstRight);
+	else if (ok)
+		CP_Batch_StripCap(&strip, p[count - 1], d0, lineCap, FALSE);
+
+	CP_Batch_Flush();
+}
+
+// Draws that were skipped during the last frame because they were entirely off screen
+CP_API unsigned CP_Graphics_GetCulledCount(void)
+{
+	return CP_Cull_GetLastFrameCount();
+}
+
+// GL draw calls of the last presented frame, once compatible calls have been merged. Always 0
+// when running headless.
+CP_API unsigned CP_Graphics_GetDrawCallCount(void)
+{
+	return (unsigned)CP_Render_GetDrawCallCount();
+}
+
 CP_API void CP_Graphics_BeginShape(void)
 {
 	CP_CorePtr CORE = GetCPCore();
@@ -313,6 +1382,8 @@ CP_API void CP_Graphics_AddVertex(float x, float y)
 	if (firstVertex)
 	{
 		nvgMoveTo(CORE->nvg, x, y);
+		shapeBounds[0] = shapeBounds[2] = x;
+		shapeBounds[1] = shapeBounds[3] = y;
 
 		// Update tracking
 		firstVertex = FALSE;
@@ -320,6 +1391,10 @@ CP_API void CP_Graphics_AddVertex(float x, float y)
 	else
 	{
 		nvgLineTo(CORE->nvg, x, y);
+		shapeBounds[0] = fminf(shapeBounds[0], x);
+		shapeBounds[1] = fminf(shapeBounds[1], y);
+		shapeBounds[2] = fmaxf(shapeBounds[2], x);
+		shapeBounds[3] = fmaxf(shapeBounds[3], y);
 	}
 }
 
@@ -328,6 +1403,11 @@ CP_API void CP_Graphics_EndShape(void)
 	CP_CorePtr CORE = GetCPCore();
 	CP_DrawInfoPtr DI = GetDrawInfo();
 
+	// the path is built as vertices are added, culling still skips its tessellation
+	// a filled shape is closed before it is stroked, otherwise the stroke ends in caps
+	if (!firstVertex && CP_Cull_Rect(shapeBounds[0], shapeBounds[1], shapeBounds[2], shapeBounds[3], CP_Graphics_StrokeReach(!DI->fill)))
+		return;
+
 	// Shape fill
 	if (DI->fill)
 	{
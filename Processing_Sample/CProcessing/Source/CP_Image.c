@@ -10,135 +10,1359 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
+#include <math.h>
 #include <stdlib.h>
 #include "cprocessing.h"
 #include "Internal_Image.h"
 #include "Internal_System.h"
+#include "tinycthread.h"
+#include "stb_image.h"
 
 //------------------------------------------------------------------------------
 // Defines and Internal Variables:
 //------------------------------------------------------------------------------
 
-#define CP_INITIAL_IMAGE_COUNT 100
+// Sprites drawn between CP_Image_BeginBatch and CP_Image_EndBatch are collected as quads
+// and drawn as one triangle list for each run of the same texture and state
+typedef struct CP_SpriteRun
+{
+	int image;
+	float alpha;
+	int filterMode;
+	int wrapMode;
+} CP_SpriteRun;
+
+static CP_BOOL      batch_active = FALSE;
+static CP_SpriteRun batch_run;
+static NVGvertex*   batch_verts = NULL;
+static int          batch_count = 0;
+static int          batch_capacity = 0;
+
+// An async screenshot is read into a pixel buffer object at the end of its frame. Once its fence
+// has passed the buffer is mapped and a job flips the rows into the capture's own memory, the
+// capture is handed to its callback on the main thread after that. The ring is only touched
+// where the GL context is current.
+typedef struct CP_CaptureRequest
+{
+	int x, y, w, h;						// top left based, bottom left once issued on GL
+	ScreenshotFunctionPtr callback;
+	void* userdata;
+} CP_CaptureRequest;
+
+typedef struct CP_CaptureSlot
+{
+	int state;
+	GLuint pbo;
+	GLsizeiptr size;
+	GLsync fence;
+	const unsigned char* source;		// mapped pixel buffer, or a read back copy without one
+	unsigned char* pixels;				// top down result the job writes to
+	CP_JobCounter counter;
+	CP_CaptureRequest request;
+} CP_CaptureSlot;
+
+// A capture that is ready to be handed to its callback
+typedef struct CP_CaptureResult
+{
+	unsigned char* pixels;
+	CP_CaptureRequest request;
+	struct CP_CaptureResult* next;
+} CP_CaptureResult;
+
+enum { CP_CAPTURE_FREE, CP_CAPTURE_READING, CP_CAPTURE_FLIPPING };
+
+#define CP_CAPTURE_RING 6
+
+static CP_CaptureSlot     capture_slots[CP_CAPTURE_RING];
+static CP_CaptureRequest* capture_requests = NULL;	// requested this frame, main thread only
+static int                capture_request_count = 0;
+static int                capture_request_max = 0;
+static int                capture_in_flight = 0;	// requested but not handed back, main thread only
+static mtx_t              capture_lock;				// guards the finished list
+static CP_BOOL            capture_lock_ready = FALSE;
+static CP_CaptureResult*  capture_finished = NULL;
+static CP_CaptureResult*  capture_finished_tail = NULL;
+
+// An image from CP_Image_LoadAsync is read and decoded by a job. Once the job is done its pixels
+// are uploaded a slice of rows at a time at the start of each frame, the whole image switches
+// from the placeholder to its texture when the last row is in.
+typedef struct CP_ImageLoad
+{
+	CP_Image image;						// NULL once the image was freed while loading
+	const char* filepath;				// interned, outlives the image
+	const unsigned char* data;			// the file in an open pack, NULL to read it from disk
+	unsigned size;
+	unsigned char* pixels;				// written by the job, NULL if the file could not be decoded
+	int w, h;
+	int rows;							// uploaded so far
+	CP_JobCounter counter;
+	struct CP_ImageLoad* next;
+} CP_ImageLoad;
+
+#define CP_IMAGE_UPLOAD_BUDGET	(4 * 1024 * 1024)	// bytes uploaded per frame, at least a row of one image
+
+// An atlas packs many images into a few large textures, its sub images draw a region of one.
+// Draws of sub images from the same page share a texture, so they batch together.
+typedef struct CP_AtlasPage
+{
+	CP_Image_Struct image;				// the texture, never handed out
+	int refs;							// sub images still using it
+} CP_AtlasPage;
+
+typedef struct CP_AtlasItem
+{
+	unsigned char* pixels;				// top down, NULL if the image could not be read
+	int w, h;
+	int page;							// -1 until it has been placed
+	int x, y;							// of the padded rect in the page
+} CP_AtlasItem;
+
+// The top edge of everything packed so far, as runs of the same height from left to right
+typedef struct CP_SkylineNode
+{
+	int x, y, w;
+} CP_SkylineNode;
+
+typedef struct CP_Skyline
+{
+	CP_SkylineNode* nodes;
+	int count;
+	int w, h;
+	int top;							// lowest edge that covers every placed rect
+} CP_Skyline;
+
+#define CP_ATLAS_SIZE		2048		// of a page, larger only for an image that does not fit
+#define CP_ATLAS_PADDING	1			// edge pixels repeated around each image so filtering does not bleed
+
+// Images loaded from a path can give up their texture when the textures go over budget, the
+// least recently drawn first. They are loaded from their path again the next time they are drawn.
+static size_t   texture_budget = 0;				// bytes, 0 for no budget
+static size_t   texture_bytes = 0;				// of every image and atlas page texture
+static CP_Image lru_head = NULL;				// least recently drawn
+static CP_Image lru_tail = NULL;
+
+static CP_ImageLoad*   load_head = NULL;			// in the order they were requested
+static CP_ImageLoad*   load_tail = NULL;
+static CP_Image_Struct placeholder_image;			// drawn in place of images that are still loading
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+// Registers a newly created image so it is found by path and freed at shutdown
+static CP_BOOL CP_AddImageHandle(CP_Image img, const char* filepath)
+{
+	img->asset = CP_Asset_Add(CP_ASSET_IMAGE, filepath, img);
+	if (img->asset == CP_ASSET_NONE)
+	{
+		return FALSE;
+	}
+	img->filepath = CP_Asset_GetPath(img->asset);
+	return TRUE;
+}
+
+static size_t CP_Image_TextureBytes(int w, int h)
+{
+	return (size_t)w * (size_t)h * 4;
+}
+
+static CP_BOOL CP_Lru_Contains(CP_Image img)
+{
+	return img->lru_prev || img == lru_head;
+}
+
+static void CP_Lru_Remove(CP_Image img)
+{
+	if (!CP_Lru_Contains(img))
+	{
+		return;
+	}
+	if (img->lru_prev)
+		img->lru_prev->lru_next = img->lru_next;
+	else
+		lru_head = img->lru_next;
+	if (img->lru_next)
+		img->lru_next->lru_prev = img->lru_prev;
+	else
+		lru_tail = img->lru_prev;
+	img->lru_prev = img->lru_next = NULL;
+}
+
+static void CP_Lru_Append(CP_Image img)
+{
+	img->lru_prev = lru_tail;
+	img->lru_next = NULL;
+	if (lru_tail)
+		lru_tail->lru_next = img;
+	else
+		lru_head = img;
+	lru_tail = img;
+}
+
+// Creates a texture from an image file, or from an open pack when it holds it. 0 on failure.
+static int CP_Image_CreateTexture(const char* filepath)
+{
+	NVGcontext* nvg = GetCPCore()->nvg;
+	const unsigned char* data = NULL;
+	unsigned size = 0;
+	if (CP_Pack_Find(filepath, &data, &size))
+	{
+		// decoded straight from the mapped memory
+		stbi_set_unpremultiply_on_load(1);
+		stbi_convert_iphone_png_to_rgb(1);
+		return nvgCreateImageMem(nvg, 0, (unsigned char*)data, (int)size);
+	}
+	return nvgCreateImage(nvg, filepath, 0);
+}
+
+// Gives up an image's texture, it is reloaded from its path when it is needed again
+static void CP_Image_Evict(CP_Image img)
+{
+	CP_Lru_Remove(img);
+	if (batch_count > 0 && batch_run.image == img->handle)
+	{
+		CP_Image_FlushBatch();
+	}
+	nvgDeleteImage(GetCPCore()->nvg, img->handle);
+	texture_bytes -= CP_Image_TextureBytes(img->w, img->h);
+	img->handle = 0;
+	img->evicted = TRUE;
+}
+
+// Loads an evicted texture again. The file can have changed since, so the size is read again,
+// and a file that no longer loads fails the image instead of being read on every draw.
+static CP_BOOL CP_Image_Reload(CP_Image img)
+{
+	img->evicted = FALSE;
+	img->handle = CP_Image_CreateTexture(img->filepath);
+	if (!img->handle)
+	{
+		img->status = CP_IMAGE_FAILED;
+		img->load_error = TRUE;
+		return FALSE;
+	}
+	nvgImageSize(GetCPCore()->nvg, img->handle, &img->w, &img->h);
+	texture_bytes += CP_Image_TextureBytes(img->w, img->h);
+	CP_Lru_Append(img);
+	return TRUE;
+}
+
+// Reloads for a caller holding pixels of the image's size, which a resized file no longer fits
+static CP_BOOL CP_Image_ReloadSameSize(CP_Image img)
+{
+	const int w = img->w;
+	const int h = img->h;
+	return CP_Image_Reload(img) && img->w == w && img->h == h;
+}
+
+// Marks an image as drawn this frame, which moves it to the back of the eviction order
+static void CP_Image_Touch(CP_Image img)
+{
+	img->last_used = CP_System_GetFrameCount();
+	if (CP_Lru_Contains(img) && img != lru_tail)
+	{
+		CP_Lru_Remove(img);
+		CP_Lru_Append(img);
+	}
+}
+
+static void CP_Capture_Shutdown(void);
+static void CP_ImageLoad_Finish(CP_ImageLoad* load);
+static void CP_Atlas_Release(CP_Image page);
+
+void CP_ImageShutdown(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!CORE || !CORE->nvg) return;
+
+	// loads still in flight are dropped once their job is done
+	while (load_head)
+	{
+		CP_ImageLoad* load = load_head;
+		load_head = load->next;
+		CP_Job_Wait(load->counter);
+		CP_ImageLoad_Finish(load);
+	}
+	load_tail = NULL;
+	if (placeholder_image.handle)
+	{
+		nvgDeleteImage(CORE->nvg, placeholder_image.handle);
+		placeholder_image.handle = 0;
+	}
+
+	int cursor = 0;
+	CP_Image img = NULL;
+	while ((img = (CP_Image)CP_Asset_Next(CP_ASSET_IMAGE, &cursor)) != NULL)
+	{
+		if (img->atlas)
+		{
+			CP_Atlas_Release(img->atlas); // the page goes with its last sub image
+		}
+		else if (img->handle)
+		{
+			nvgDeleteImage(CORE->nvg, img->handle); // free nanoVG's data
+		}
+		free(img); // free the image struct
+	}
+	lru_head = lru_tail = NULL;
+	texture_bytes = 0;
+
+	free(batch_verts);
+	batch_verts = NULL;
+	batch_count = batch_capacity = 0;
+
+	CP_Capture_Shutdown();
+}
+
+void CP_Image_FlushBatch(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (batch_count == 0 || !CORE || !CORE->nvg)
+	{
+		batch_count = 0;
+		return;
+	}
+
+	NVGpaint paint;
+	memset(&paint, 0, sizeof(NVGpaint));
+	nvgTransformIdentity(paint.xform);
+	paint.image = batch_run.image;
+	paint.innerColor = paint.outerColor = nvgRGBAf(1, 1, 1, batch_run.alpha);
+	paint.textureFilterMode = batch_run.filterMode;
+	paint.textureWrapMode = batch_run.wrapMode;
+
+	// the quads are already transformed, draw them without the current transform
+	float xform[6];
+	nvgCurrentTransform(CORE->nvg, xform);
+	nvgResetTransform(CORE->nvg);
+	nvgTriangles(CORE->nvg, paint, batch_verts, batch_count);
+	nvgTransform(CORE->nvg, xform[0], xform[1], xform[2], xform[3], xform[4], xform[5]);
+
+	batch_count = 0;
+}
+
+// Returns FALSE when the vertex buffer could not grow, the batch is flushed and the caller draws the image directly
+static CP_BOOL CP_Image_BatchQuad(CP_Image img, float x, float y, float w, float h, float s0, float t0, float s1, float t1, float alpha, float degrees)
+{
+	CP_CorePtr CORE = GetCPCore();
+	int filterMode = nvgCurrentTextureFilter(CORE->nvg);
+	int wrapMode = nvgCurrentTextureWrap(CORE->nvg);
+
+	// a different texture or state starts a new run
+	if (batch_count > 0 && (batch_run.image != img->handle || batch_run.alpha != alpha ||
+		batch_run.filterMode != filterMode || batch_run.wrapMode != wrapMode))
+	{
+		CP_Image_FlushBatch();
+	}
+
+	if (batch_count + 6 > batch_capacity)
+	{
+		int capacity = batch_capacity < 1024 ? 1024 : batch_capacity * 2;
+		NVGvertex* verts = (NVGvertex*)realloc(batch_verts, capacity * sizeof(NVGvertex));
+		if (!verts)
+		{
+			CP_Image_FlushBatch();
+			return FALSE;
+		}
+		batch_verts = verts;
+		batch_capacity = capacity;
+	}
+
+	batch_run.image = img->handle;
+	batch_run.alpha = alpha;
+	batch_run.filterMode = filterMode;
+	batch_run.wrapMode = wrapMode;
+
+	// the whole image unless a sub image was given in pixels
+	float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+	if (s0 != s1 && t0 != t1)
+	{
+		u0 = s0 / img->w;
+		v0 = t0 / img->h;
+		u1 = s1 / img->w;
+		v1 = t1 / img->h;
+	}
+	if (img->flip_y)
+	{
+		v0 = 1.0f - v0;
+		v1 = 1.0f - v1;
+	}
+
+	// rotate around the center, then apply the current transform
+	float xform[6];
+	nvgCurrentTransform(CORE->nvg, xform);
+	float c = 1.0f, s = 0;
+	if (degrees != 0)
+	{
+		float radians = CP_Math_Radians(degrees);
+		c = cosf(radians);
+		s = sinf(radians);
+	}
+	float cx = x + w * 0.5f;
+	float cy = y + h * 0.5f;
+	float px = xform[0] * cx + xform[2] * cy + xform[4];
+	float py = xform[1] * cx + xform[3] * cy + xform[5];
+	float ax = (xform[0] * c + xform[2] * s) * w * 0.5f;
+	float ay = (xform[1] * c + xform[3] * s) * w * 0.5f;
+	float bx = (xform[2] * c - xform[0] * s) * h * 0.5f;
+	float by = (xform[3] * c - xform[1] * s) * h * 0.5f;
+
+	NVGvertex* v = &batch_verts[batch_count];
+	v[0].x = px - ax - bx;	v[0].y = py - ay - by;	v[0].u = u0;	v[0].v = v0;
+	v[1].x = px + ax - bx;	v[1].y = py + ay - by;	v[1].u = u1;	v[1].v = v0;
+	v[2].x = px + ax + bx;	v[2].y = py + ay + by;	v[2].u = u1;	v[2].v = v1;
+	v[3] = v[0];
+	v[4] = v[2];
+	v[5].x = px - ax + bx;	v[5].y = py - ay + by;	v[5].u = u0;	v[5].v = v1;
+	batch_count += 6;
+	return TRUE;
+}
+
+static void CP_Image_DrawInternal(CP_Image img, float x, float y, float w, float h, float s0, float t0, float s1, float t1, int alpha, float degrees)
+{
+	if (!img)
+	{
+		return;
+	}
+
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+
+	if (!CORE || !CORE->nvg || !DI)
+	{
+		return;
+	}
+
+	// the image asked for, img can become the placeholder or an atlas page below
+	CP_Image drawn = img;
+
+	if (img->status != CP_IMAGE_READY)
+	{
+		if (img->status == CP_IMAGE_FAILED || !placeholder_image.handle)
+		{
+			return;
+		}
+		// the whole placeholder stands in for any part of the image
+		img = &placeholder_image;
+		s0 = s1 = t0 = t1 = 0;
+	}
+
+	// a sub image draws its region of the atlas texture
+	if (img->atlas)
+	{
+		if (s0 == s1 || t0 == t1)
+		{
+			s0 = t0 = 0;
+			s1 = (float)img->w;
+			t1 = (float)img->h;
+		}
+		s0 += img->atlas_x;
+		s1 += img->atlas_x;
+		t0 += img->atlas_y;
+		t1 += img->atlas_y;
+		img = img->atlas;
+	}
+
+	switch (DI->image_mode)
+	{
+	case CP_POSITION_CENTER:
+		x -= w * 0.5f;
+		y -= h * 0.5f;
+		break;
+	case CP_POSITION_CORNER:
+		// default for NanoVG
+	default:
+		break;
+	}
+
+	if (degrees != 0)
+	{
+		// rotated around its center, the image stays within the circle through its corners
+		float r = sqrtf(w * w + h * h) * 0.5f;
+		float cx = x + w * 0.5f;
+		float cy = y + h * 0.5f;
+		if (CP_Cull_Rect(cx - r, cy - r, cx + r, cy + r, 0))
+			return;
+	}
+	else if (CP_Cull_Rect(x, y, x + w, y + h, 0))
+	{
+		return;
+	}
+
+	// a texture given up for the texture budget is loaded again once it is on screen, culled
+	// images are not touched so they stay first in line to be evicted
+	if (drawn->evicted && !CP_Image_Reload(drawn))
+	{
+		return;
+	}
+	CP_Image_Touch(drawn);
+
+	const float a = CP_Math_ClampInt(alpha, 0, 255) / 255.0f;
+
+	if (batch_active && CP_Image_BatchQuad(img, x, y, w, h, s0, t0, s1, t1, a, degrees))
+	{
+		return;
+	}
+
+	// translate and scale image pattern for subimages
+	NVGpaint image = { 0 };
+	if (s0 != s1 && t0 != t1)
+	{
+		const float posRatioX = (w / (s1 - s0));
+		const float posRatioY = (h / (t1 - t0));
+		const float scaleRatioX = (img->w / w) * posRatioX;
+		const float scaleRatioY = (img->h / h) * posRatioY;
+
+		image = nvgImagePattern(CORE->nvg, x - s0 * posRatioX, y - t0 * posRatioY, w * scaleRatioX, h * scaleRatioY, 0, img->handle, a);
+	}
+	else
+	{
+		image = nvgImagePattern(CORE->nvg, x, y, w, h, 0, img->handle, a);
+	}
+
+	// rotation
+	nvgSave(CORE->nvg);
+	nvgTranslate(CORE->nvg, x + (w / 2.0f), y + (h / 2.0f));
+	nvgRotate(CORE->nvg, CP_Math_Radians(degrees));
+	nvgTranslate(CORE->nvg, -(x + (w / 2.0f)), -(y + (h / 2.0f)));
+
+	nvgBeginPath(CORE->nvg);
+	nvgRect(CORE->nvg, x, y, w, h);
+	nvgFillPaint(CORE->nvg, image);
+	nvgFill(CORE->nvg);
+
+	nvgRestore(CORE->nvg);
+}
+
+// Runs on a worker, reading and decoding the file the same way nvgCreateImage does
+static void CP_ImageLoad_Job(void* data)
+{
+	CP_ImageLoad* load = (CP_ImageLoad*)data;
+	int channels = 0;
+	if (load->data)
+	{
+		load->pixels = stbi_load_from_memory(load->data, (int)load->size, &load->w, &load->h, &channels, 4);
+	}
+	else
+	{
+		load->pixels = stbi_load(load->filepath, &load->w, &load->h, &channels, 4);
+	}
+}
+
+// Uploads the next rows of a decoded image, returns how many bytes that was
+static int CP_ImageLoad_Upload(CP_ImageLoad* load, int budget)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_Image img = load->image;
+	if (!img->handle)
+	{
+		// the texture is created empty and filled in over the next frames
+		img->handle = nvgCreateImageRGBA(CORE->nvg, load->w, load->h, 0, NULL);
+		if (!img->handle)
+		{
+			stbi_image_free(load->pixels);
+			load->pixels = NULL;
+			return 0;
+		}
+		img->w = load->w;
+		img->h = load->h;
+		texture_bytes += CP_Image_TextureBytes(img->w, img->h);
+	}
+
+	const int stride = load->w * 4;
+	int rows = budget / stride;
+	if (rows < 1)
+	{
+		rows = 1;
+	}
+	if (rows > load->h - load->rows)
+	{
+		rows = load->h - load->rows;
+	}
+
+	// the region is taken from the whole image at the same offset
+	nvgUpdateImageRegion(CORE->nvg, img->handle, 0, load->rows, load->w, rows, load->pixels);
+	load->rows += rows;
+	return rows * stride;
+}
+
+// Hands a load's result to its image and frees it, the job has to be done
+static void CP_ImageLoad_Finish(CP_ImageLoad* load)
+{
+	CP_Image img = load->image;
+	if (img)
+	{
+		img->status = load->pixels && load->rows == load->h ? CP_IMAGE_READY : CP_IMAGE_FAILED;
+		img->load_error = img->status == CP_IMAGE_FAILED;
+		img->load = NULL;
+		if (img->status == CP_IMAGE_READY)
+		{
+			img->last_used = CP_System_GetFrameCount();
+			CP_Lru_Append(img);
+		}
+	}
+	stbi_image_free(load->pixels);
+	CP_Job_FreeCounter(&load->counter);
+	free(load);
+}
+
+static void CP_ImageLoad_Unlink(CP_ImageLoad* load)
+{
+	CP_ImageLoad* prev = NULL;
+	for (CP_ImageLoad* it = load_head; it; prev = it, it = it->next)
+	{
+		if (it == load)
+		{
+			if (prev)
+				prev->next = load->next;
+			else
+				load_head = load->next;
+			if (load_tail == load)
+				load_tail = prev;
+			return;
+		}
+	}
+}
+
+// Waits for an image that is still loading and uploads the rest of it right away
+static void CP_ImageLoad_Complete(CP_Image img)
+{
+	CP_ImageLoad* load = img->load;
+	CP_Job_Wait(load->counter);
+	if (load->pixels)
+	{
+		CP_ImageLoad_Upload(load, load->w * 4 * load->h);
+	}
+	CP_ImageLoad_Unlink(load);
+	CP_ImageLoad_Finish(load);
+}
+
+// A small grey checker, created the first time an image is loaded asynchronously
+static void CP_Image_CreatePlaceholder(void)
+{
+	static const unsigned char pixels[2 * 2 * 4] =
+	{
+		160, 160, 160, 255,		96, 96, 96, 255,
+		96, 96, 96, 255,		160, 160, 160, 255
+	};
+
+	memset(&placeholder_image, 0, sizeof(placeholder_image));
+	placeholder_image.handle = nvgCreateImageRGBA(GetCPCore()->nvg, 2, 2, 0, pixels);
+	placeholder_image.w = 2;
+	placeholder_image.h = 2;
+	placeholder_image.asset = CP_ASSET_NONE;
+	placeholder_image.status = CP_IMAGE_READY;
+}
+
+// Uploads the decoded images a slice at a time, called at the start of each frame
+void CP_Image_LoadFrameStart(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!load_head || !CORE || !CORE->nvg)
+	{
+		return;
+	}
+
+	CP_Profile_Begin("Image Upload");
+	int budget = CP_IMAGE_UPLOAD_BUDGET;
+	CP_ImageLoad* prev = NULL;
+	CP_ImageLoad* load = load_head;
+	while (load)
+	{
+		CP_ImageLoad* next = load->next;
+		if (!CP_Job_IsDone(load->counter))
+		{
+			prev = load;
+			load = next;
+			continue;
+		}
+
+		if (load->image && load->pixels && budget > 0)
+		{
+			budget -= CP_ImageLoad_Upload(load, budget);
+		}
+
+		// finished, failed to decode or freed while loading
+		if (!load->image || !load->pixels || load->rows == load->h)
+		{
+			if (prev)
+				prev->next = next;
+			else
+				load_head = next;
+			if (load_tail == load)
+				load_tail = prev;
+			CP_ImageLoad_Finish(load);
+		}
+		else
+		{
+			prev = load;
+		}
+		load = next;
+	}
+	CP_Profile_End();
+}
+
+// The y a rect would rest at when its left edge is at node i, -1 if it does not fit there
+static int CP_Skyline_Fit(const CP_Skyline* sky, int i, int w, int h)
+{
+	if (sky->nodes[i].x + w > sky->w)
+	{
+		return -1;
+	}
+
+	int y = 0;
+	for (int remaining = w; remaining > 0; remaining -= sky->nodes[i++].w)
+	{
+		if (sky->nodes[i].y > y)
+		{
+			y = sky->nodes[i].y;
+		}
+		if (y + h > sky->h)
+		{
+			return -1;
+		}
+	}
+	return y;
+}
+
+// Places a rect where its top edge ends up lowest, the narrowest spot on a tie
+static CP_BOOL CP_Skyline_Place(CP_Skyline* sky, int w, int h, int* x, int* y)
+{
+	int best = -1, bestTop = 0, bestWidth = 0, bestY = 0;
+	for (int i = 0; i < sky->count; ++i)
+	{
+		int fit = CP_Skyline_Fit(sky, i, w, h);
+		if (fit >= 0 && (best < 0 || fit + h < bestTop || (fit + h == bestTop && sky->nodes[i].w < bestWidth)))
+		{
+			best = i;
+			bestTop = fit + h;
+			bestWidth = sky->nodes[i].w;
+			bestY = fit;
+		}
+	}
+	if (best < 0)
+	{
+		return FALSE;
+	}
+
+	// the rect's top edge becomes a node, the nodes underneath it are cut back or removed
+	CP_SkylineNode* nodes = sky->nodes;
+	memmove(&nodes[best + 1], &nodes[best], (sky->count - best) * sizeof(CP_SkylineNode));
+	nodes[best].y = bestY + h;
+	nodes[best].w = w;
+	++sky->count;
+	*x = nodes[best].x;
+	*y = bestY;
+	for (int i = best + 1; i < sky->count;)
+	{
+		int overlap = nodes[best].x + nodes[best].w - nodes[i].x;
+		if (overlap <= 0)
+		{
+			break;
+		}
+		nodes[i].x += overlap;
+		nodes[i].w -= overlap;
+		if (nodes[i].w > 0)
+		{
+			break;
+		}
+		memmove(&nodes[i], &nodes[i + 1], (sky->count - i - 1) * sizeof(CP_SkylineNode));
+		--sky->count;
+	}
+
+	// neighbours at the same height become one node
+	for (int i = 0; i + 1 < sky->count;)
+	{
+		if (nodes[i].y == nodes[i + 1].y)
+		{
+			nodes[i].w += nodes[i + 1].w;
+			memmove(&nodes[i + 1], &nodes[i + 2], (sky->count - i - 2) * sizeof(CP_SkylineNode));
+			--sky->count;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	if (bestTop > sky->top)
+	{
+		sky->top = bestTop;
+	}
+	return TRUE;
+}
+
+static int CP_Atlas_CompareItems(const void* a, const void* b)
+{
+	const CP_AtlasItem* ia = *(const CP_AtlasItem* const*)a;
+	const CP_AtlasItem* ib = *(const CP_AtlasItem* const*)b;
+	if (ia->h != ib->h)
+	{
+		return ib->h - ia->h;
+	}
+	return ib->w - ia->w;
+}
+
+// Copies the page's images in with their edges repeated into the padding and uploads it
+static CP_AtlasPage* CP_Atlas_CreatePage(CP_AtlasItem* items, int count, int page, int w, int h)
+{
+	unsigned char* pixels = (unsigned char*)calloc((size_t)w * h, 4);
+	CP_AtlasPage* atlas = (CP_AtlasPage*)calloc(1, sizeof(CP_AtlasPage));
+	if (!pixels || !atlas)
+	{
+		free(pixels);
+		free(atlas);
+		return NULL;
+	}
+
+	const int pad = CP_ATLAS_PADDING;
+	for (int i = 0; i < count; ++i)
+	{
+		const CP_AtlasItem* item = &items[i];
+		if (item->page != page)
+		{
+			continue;
+		}
+		for (int row = -pad; row < item->h + pad; ++row)
+		{
+			const unsigned char* src = &item->pixels[CP_Math_ClampInt(row, 0, item->h - 1) * item->w * 4];
+			unsigned char* dst = &pixels[((item->y + pad + row) * w + item->x) * 4];
+			for (int col = 0; col < pad; ++col)
+			{
+				memcpy(&dst[col * 4], src, 4);
+				memcpy(&dst[(pad + item->w + col) * 4], &src[(item->w - 1) * 4], 4);
+			}
+			memcpy(&dst[pad * 4], src, item->w * 4);
+		}
+	}
+
+	atlas->image.handle = nvgCreateImageRGBA(GetCPCore()->nvg, w, h, 0, pixels);
+	free(pixels);
+	if (!atlas->image.handle)
+	{
+		free(atlas);
+		return NULL;
+	}
+	atlas->image.w = w;
+	atlas->image.h = h;
+	texture_bytes += CP_Image_TextureBytes(w, h);
+	atlas->image.asset = CP_ASSET_NONE;
+	atlas->image.status = CP_IMAGE_READY;
+	return atlas;
+}
+
+static void CP_Atlas_Release(CP_Image page)
+{
+	CP_AtlasPage* atlas = (CP_AtlasPage*)page;
+	if (--atlas->refs > 0)
+	{
+		return;
+	}
+	if (batch_count > 0 && batch_run.image == atlas->image.handle)
+	{
+		CP_Image_FlushBatch();
+	}
+	nvgDeleteImage(GetCPCore()->nvg, atlas->image.handle);
+	texture_bytes -= CP_Image_TextureBytes(atlas->image.w, atlas->image.h);
+	free(atlas);
+}
+
+// Packs the items into as few pages as it takes and hands out a sub image for each of them
+static CP_BOOL CP_Atlas_Create(CP_AtlasItem* items, int count, CP_Image* subImages)
+{
+	const int pad = CP_ATLAS_PADDING;
+	CP_AtlasItem** order = (CP_AtlasItem**)malloc(count * sizeof(CP_AtlasItem*));
+	if (!order)
+	{
+		return FALSE;
+	}
+
+	// tallest first packs tightest on a skyline
+	int remaining = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		subImages[i] = NULL;
+		items[i].page = -1;
+		if (items[i].pixels)
+		{
+			order[remaining++] = &items[i];
+		}
+	}
+	qsort(order, remaining, sizeof(CP_AtlasItem*), CP_Atlas_CompareItems);
+
+	CP_BOOL success = remaining == count;
+	for (int page = 0; remaining > 0; ++page)
+	{
+		// a page grows to fit an image larger than the usual size on its own
+		CP_Skyline sky;
+		memset(&sky, 0, sizeof(CP_Skyline));
+		sky.w = sky.h = CP_ATLAS_SIZE;
+		for (int i = 0; i < remaining; ++i)
+		{
+			sky.w = order[i]->w + 2 * pad > sky.w ? order[i]->w + 2 * pad : sky.w;
+			sky.h = order[i]->h + 2 * pad > sky.h ? order[i]->h + 2 * pad : sky.h;
+		}
+		// every node is at least a pixel wide
+		sky.nodes = (CP_SkylineNode*)malloc((sky.w + 1) * sizeof(CP_SkylineNode));
+		if (!sky.nodes)
+		{
+			success = FALSE;
+			break;
+		}
+		sky.nodes[0].x = sky.nodes[0].y = 0;
+		sky.nodes[0].w = sky.w;
+		sky.count = 1;
+
+		int left = 0;
+		for (int i = 0; i < remaining; ++i)
+		{
+			CP_AtlasItem* item = order[i];
+			if (CP_Skyline_Place(&sky, item->w + 2 * pad, item->h + 2 * pad, &item->x, &item->y))
+				item->page = page;
+			else
+				order[left++] = item;
+		}
+		remaining = left;
+		free(sky.nodes);
+
+		// the page ends where the packed images do
+		CP_AtlasPage* atlas = CP_Atlas_CreatePage(items, count, page, sky.w, sky.top);
+		for (int i = 0; i < count; ++i)
+		{
+			CP_AtlasItem* item = &items[i];
+			if (item->page != page)
+			{
+				continue;
+			}
+
+			CP_Image img = atlas ? (CP_Image)calloc(1, sizeof(CP_Image_Struct)) : NULL;
+			if (!img)
+			{
+				success = FALSE;
+				continue;
+			}
+			img->atlas = &atlas->image;
+			img->atlas_x = item->x + pad;
+			img->atlas_y = item->y + pad;
+			img->w = item->w;
+			img->h = item->h;
+			img->status = CP_IMAGE_READY;
+			if (!CP_AddImageHandle(img, NULL))
+			{
+				free(img);
+				success = FALSE;
+				continue;
+			}
+			++atlas->refs;
+			subImages[i] = img;
+		}
+
+		// no sub image could be made from it
+		if (atlas && atlas->refs == 0)
+		{
+			++atlas->refs;
+			CP_Atlas_Release(&atlas->image);
+		}
+	}
+
+	free(order);
+	return success;
+}
+
+typedef struct CP_AtlasDecode
+{
+	const char** filepaths;
+	CP_AtlasItem* items;
+} CP_AtlasDecode;
+
+static void CP_Atlas_DecodeRange(int begin, int end, void* userdata)
+{
+	const CP_AtlasDecode* decode = (const CP_AtlasDecode*)userdata;
+	for (int i = begin; i < end; ++i)
+	{
+		const char* filepath = decode->filepaths[i];
+		CP_AtlasItem* item = &decode->items[i];
+		const unsigned char* data = NULL;
+		unsigned size = 0;
+		int channels = 0;
+		if (!filepath)
+			item->pixels = NULL;
+		else if (CP_Pack_Find(filepath, &data, &size))
+			item->pixels = stbi_load_from_memory(data, (int)size, &item->w, &item->h, &channels, 4);
+		else
+			item->pixels = stbi_load(filepath, &item->w, &item->h, &channels, 4);
+	}
+}
+
+// Reads an image back top down into new memory, NULL if there is nothing to read
+static unsigned char* CP_Image_ReadPixels(CP_Image img)
+{
+	if (img->load)
+	{
+		CP_ImageLoad_Complete(img);
+	}
+	if (img->evicted && !CP_Image_Reload(img))
+	{
+		return NULL;
+	}
+	if (img->status != CP_IMAGE_READY || img->w <= 0 || img->h <= 0)
+	{
+		return NULL;
+	}
+
+	CP_Image source = img->atlas ? img->atlas : img;
+	unsigned char* all = (unsigned char*)malloc((size_t)source->w * source->h * 4);
+	if (!all || !nvgGetImagePixelsRGBA(GetCPCore()->nvg, source->handle, all))
+	{
+		free(all);
+		return NULL;
+	}
+	if (!img->atlas && !img->flip_y)
+	{
+		return all;
+	}
+
+	// a region of an atlas, or the rows turned around
+	unsigned char* pixels = (unsigned char*)malloc((size_t)img->w * img->h * 4);
+	if (pixels)
+	{
+		for (int row = 0; row < img->h; ++row)
+		{
+			int srcRow = img->atlas_y + (img->flip_y ? img->h - row - 1 : row);
+			memcpy(&pixels[row * img->w * 4], &all[(srcRow * source->w + img->atlas_x) * 4], img->w * 4);
+		}
+	}
+	free(all);
+	return pixels;
+}
+
+// Copies a top left based region of the software framebuffer, areas outside of it read as transparent black
+static void CP_ScreenshotHeadless(int x, int y, int w, int h, unsigned char* buffer)
+{
+	int fbWidth = 0, fbHeight = 0;
+	unsigned char* pixels = nvgswFramebuffer(GetCPCore()->nvg, &fbWidth, &fbHeight);
+
+	memset(buffer, 0, 4 * w * h);
+	for (int row = 0; row < h; ++row)
+	{
+		int srcY = y + row;
+		if (srcY < 0 || srcY >= fbHeight)
+			continue;
+
+		int x0 = CP_Math_ClampInt(x, 0, fbWidth);
+		int x1 = CP_Math_ClampInt(x + w, 0, fbWidth);
+		if (x1 > x0)
+		{
+			memcpy(&buffer[(row * w + (x0 - x)) * 4], &pixels[(srcY * fbWidth + x0) * 4], (x1 - x0) * 4);
+		}
+	}
+}
+
+// A region of the GL framebuffer to read back, bottom left based
+typedef struct CP_ReadRegion
+{
+	int x, y, w, h;
+	unsigned char* buffer;
+} CP_ReadRegion;
+
+static void CP_ReadPixelsGL(void* data)
+{
+	const CP_ReadRegion* region = (const CP_ReadRegion*)data;
+	glReadPixels(region->x, region->y, region->w, region->h, GL_RGBA, GL_UNSIGNED_BYTE, region->buffer);
+}
+
+static void CP_Capture_Finish(unsigned char* pixels, const CP_CaptureRequest* request)
+{
+	CP_CaptureResult* result = (CP_CaptureResult*)malloc(sizeof(CP_CaptureResult));
+	if (!result)
+	{
+		free(pixels);
+		pixels = NULL;
+	}
 
-static CP_Image* images = NULL;
-static unsigned  image_num = 0;
-static unsigned  image_max = CP_INITIAL_IMAGE_COUNT;
+	mtx_lock(&capture_lock);
+	if (result)
+	{
+		result->pixels = pixels;
+		result->request = *request;
+		result->next = NULL;
+		if (capture_finished_tail)
+			capture_finished_tail->next = result;
+		else
+			capture_finished = result;
+		capture_finished_tail = result;
+	}
+	mtx_unlock(&capture_lock);
+}
 
-//------------------------------------------------------------------------------
-// Internal Functions:
-//------------------------------------------------------------------------------
+// Runs on a worker, GL rows are bottom to top
+static void CP_Capture_FlipJob(void* data)
+{
+	CP_CaptureSlot* slot = (CP_CaptureSlot*)data;
+	const int rowWidth = slot->request.w * 4;
+	const int h = slot->request.h;
+	for (int row = 0; row < h; ++row)
+	{
+		memcpy(&slot->pixels[row * rowWidth], &slot->source[(h - row - 1) * rowWidth], rowWidth);
+	}
+}
 
-static CP_Image CP_CheckIfImageIsLoaded(const char* filepath)
+static void CP_Capture_StartFlip(CP_CaptureSlot* slot, const unsigned char* source)
 {
-	for (unsigned i = 0; i < image_num; ++i)
+	slot->source = source;
+	slot->pixels = (unsigned char*)malloc((size_t)slot->request.w * slot->request.h * 4);
+	slot->state = CP_CAPTURE_FLIPPING;
+	if (!slot->counter)
 	{
-		if (images[i] && !strcmp(filepath, images[i]->filepath))
-		{
-			return images[i];
-		}
+		slot->counter = CP_Job_CreateCounter();
+	}
+	if (slot->pixels && source)
+	{
+		CP_Job_Submit(CP_Capture_FlipJob, slot, slot->counter);
 	}
+}
 
-	return NULL;
+static void CP_Capture_Release(CP_CaptureSlot* slot)
+{
+	if (!slot->pbo)
+	{
+		free((void*)slot->source);
+	}
+	else if (slot->source)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+	slot->source = NULL;
+	slot->state = CP_CAPTURE_FREE;
 }
 
-static void CP_AddImageHandle(CP_Image img)
+static void CP_Capture_IssueGL(void* data)
 {
-	// allocate the array if it doesnt exist
-	if (images == NULL)
+	const CP_CaptureRequest* request = (const CP_CaptureRequest*)data;
+	const GLsizeiptr size = (GLsizeiptr)request->w * request->h * 4;
+
+	CP_CaptureSlot* slot = NULL;
+	for (int i = 0; i < CP_CAPTURE_RING && !slot; ++i)
+	{
+		if (capture_slots[i].state == CP_CAPTURE_FREE)
+			slot = &capture_slots[i];
+	}
+	if (!slot)
+	{
+		// every slot is busy, the capture can only be handed back empty
+		CP_Capture_Finish(NULL, request);
+		return;
+	}
+	slot->request = *request;
+
+	// without fences and mapped ranges the read blocks, the flip still moves off this thread
+	if (!GLAD_GL_VERSION_3_2)
+	{
+		unsigned char* copy = (unsigned char*)malloc(size);
+		if (copy)
+		{
+			glReadPixels(request->x, request->y, request->w, request->h, GL_RGBA, GL_UNSIGNED_BYTE, copy);
+		}
+		CP_Capture_StartFlip(slot, copy);
+		return;
+	}
+
+	if (!slot->pbo)
 	{
-		images = (CP_Image*)calloc(CP_INITIAL_IMAGE_COUNT, sizeof(CP_Image));
+		glGenBuffers(1, &slot->pbo);
 	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+	if (slot->size < size)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+		slot->size = size;
+	}
+	glReadPixels(request->x, request->y, request->w, request->h, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-	// track the image handle for unloading
-	images[image_num++] = img;
+	slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	slot->state = CP_CAPTURE_READING;
+}
 
-	if (image_num == image_max)
+// Moves finished reads on to their flip job and finished flips on to the main thread
+static void CP_Capture_PollGL(void* data)
+{
+	(void)data;
+	for (int i = 0; i < CP_CAPTURE_RING; ++i)
 	{
-		// store the current array
-		CP_Image * temp = images;
-		// allocate an array twice the size
-		images = (CP_Image*)calloc(image_max * 2, sizeof(CP_Image));
-		// copy over the old data
-		memcpy_s(images, image_max * 2 * sizeof(CP_Image), temp, image_max * sizeof(CP_Image));
-		// double the size
-		image_max *= 2;
-		// free the old array
-		free(temp);
+		CP_CaptureSlot* slot = &capture_slots[i];
+		if (slot->state == CP_CAPTURE_READING)
+		{
+			GLenum status = glClientWaitSync(slot->fence, 0, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			{
+				continue;
+			}
+			glDeleteSync(slot->fence);
+			slot->fence = NULL;
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+			const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)slot->request.w * slot->request.h * 4, GL_MAP_READ_BIT);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			CP_Capture_StartFlip(slot, (const unsigned char*)mapped);
+		}
+
+		if (slot->state == CP_CAPTURE_FLIPPING && CP_Job_IsDone(slot->counter))
+		{
+			if (!slot->source)
+			{
+				free(slot->pixels);
+				slot->pixels = NULL;
+			}
+			CP_Capture_Finish(slot->pixels, &slot->request);
+			slot->pixels = NULL;
+			CP_Capture_Release(slot);
+		}
 	}
 }
 
-void CP_ImageShutdown(void)
+// Waits for everything in the ring and frees it, captures still in flight are dropped
+static void CP_Capture_ShutdownGL(void* data)
 {
-	CP_CorePtr CORE = GetCPCore();
-	if (!CORE || !CORE->nvg) return;
-	for (unsigned i = 0; i < image_num; ++i)
+	(void)data;
+	for (int i = 0; i < CP_CAPTURE_RING; ++i)
 	{
-		if (images[i]) // check if its null
+		CP_CaptureSlot* slot = &capture_slots[i];
+		if (slot->state == CP_CAPTURE_READING)
 		{
-			nvgDeleteImage(CORE->nvg, images[i]->handle); // free nanoVG's data
-			free(images[i]); // free the image struct
+			glDeleteSync(slot->fence);
+			slot->fence = NULL;
+			slot->state = CP_CAPTURE_FREE;
 		}
+		if (slot->state == CP_CAPTURE_FLIPPING)
+		{
+			CP_Job_Wait(slot->counter);
+			free(slot->pixels);
+			slot->pixels = NULL;
+			CP_Capture_Release(slot);
+		}
+		if (slot->pbo)
+		{
+			glDeleteBuffers(1, &slot->pbo);
+		}
+		CP_Job_FreeCounter(&slot->counter);
+		memset(slot, 0, sizeof(CP_CaptureSlot));
 	}
 }
 
-static void CP_Image_DrawInternal(CP_Image img, float x, float y, float w, float h, float s0, float t0, float s1, float t1, int alpha, float degrees)
+// Hands finished captures to their callbacks, the pixels are only valid during the call
+static void CP_Capture_Deliver(void)
 {
-	if (!img)
+	if (!capture_lock_ready)
 	{
 		return;
 	}
 
-	CP_CorePtr CORE = GetCPCore();
-	CP_DrawInfoPtr DI = GetDrawInfo();
+	mtx_lock(&capture_lock);
+	CP_CaptureResult* result = capture_finished;
+	capture_finished = capture_finished_tail = NULL;
+	mtx_unlock(&capture_lock);
 
-	if (!CORE || !CORE->nvg || !DI)
+	while (result)
 	{
-		return;
+		CP_CaptureResult* next = result->next;
+		--capture_in_flight;
+		if (result->request.callback)
+		{
+			result->request.callback((const CP_Color*)result->pixels, result->pixels ? result->request.w : 0,
+				result->pixels ? result->request.h : 0, result->request.userdata);
+		}
+		free(result->pixels);
+		free(result);
+		result = next;
 	}
+}
 
-	switch (DI->image_mode)
+// Drops the captures still in flight without calling back
+static void CP_Capture_Shutdown(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (capture_lock_ready)
 	{
-	case CP_POSITION_CENTER:
-		x -= w * 0.5f;
-		y -= h * 0.5f;
-		break;
-	case CP_POSITION_CORNER:
-		// default for NanoVG
-	default:
-		break;
+		if (!CORE->isHeadless)
+		{
+			CP_Render_Call(CP_Capture_ShutdownGL, NULL, 0);
+			CP_Render_Sync();
+		}
+		while (capture_finished)
+		{
+			CP_CaptureResult* next = capture_finished->next;
+			free(capture_finished->pixels);
+			free(capture_finished);
+			capture_finished = next;
+		}
+		capture_finished_tail = NULL;
+		mtx_destroy(&capture_lock);
+		capture_lock_ready = FALSE;
 	}
+	free(capture_requests);
+	capture_requests = NULL;
+	capture_request_count = capture_request_max = 0;
+	capture_in_flight = 0;
+}
 
-	const float a = CP_Math_ClampInt(alpha, 0, 255) / 255.0f;
+// Reads this frame's async screenshots and hands back the ones that have finished, called once
+// the frame has ended and before it is presented
+void CP_Image_CaptureFrameEnd(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (capture_in_flight == 0 || !CORE || !CORE->nvg)
+	{
+		return;
+	}
 
-	// translate and scale image pattern for subimages
-	NVGpaint image = { 0 };
-	if (s0 != s1 && t0 != t1)
+	CP_Profile_Begin("Capture");
+	CP_Capture_Deliver();
+
+	for (int i = 0; i < capture_request_count; ++i)
 	{
-		const float posRatioX = (w / (s1 - s0));
-		const float posRatioY = (h / (t1 - t0));
-		const float scaleRatioX = (img->w / w) * posRatioX;
-		const float scaleRatioY = (img->h / h) * posRatioY;
+		CP_CaptureRequest* request = &capture_requests[i];
+		if (CORE->isHeadless)
+		{
+			// the software framebuffer is already top down and in memory
+			unsigned char* pixels = (unsigned char*)malloc((size_t)request->w * request->h * 4);
+			if (pixels)
+			{
+				CP_ScreenshotHeadless(request->x, request->y, request->w, request->h, pixels);
+			}
+			CP_Capture_Finish(pixels, request);
+			continue;
+		}
 
-		image = nvgImagePattern(CORE->nvg, x - s0 * posRatioX, y - t0 * posRatioY, w * scaleRatioX, h * scaleRatioY, 0, img->handle, a);
+		// glReadPixels uses x,y as the lower left
+		request->y = (CORE->window_height - request->h) - request->y;
+		CP_Render_Call(CP_Capture_IssueGL, request, sizeof(CP_CaptureRequest));
 	}
-	else
+	capture_request_count = 0;
+
+	if (!CORE->isHeadless)
 	{
-		image = nvgImagePattern(CORE->nvg, x, y, w, h, 0, img->handle, a);
+		CP_Render_Call(CP_Capture_PollGL, NULL, 0);
 	}
+	CP_Profile_End();
+}
 
-	// rotation
-	nvgSave(CORE->nvg);
-	nvgTranslate(CORE->nvg, x + (w / 2.0f), y + (h / 2.0f));
-	nvgRotate(CORE->nvg, CP_Math_Radians(degrees));
-	nvgTranslate(CORE->nvg, -(x + (w / 2.0f)), -(y + (h / 2.0f)));
-
-	nvgBeginPath(CORE->nvg);
-	nvgRect(CORE->nvg, x, y, w, h);
-	nvgFillPaint(CORE->nvg, image);
-	nvgFill(CORE->nvg);
+// Evicts the least recently drawn images until the textures fit the budget again, images drawn
+// this frame are kept
+void CP_Image_BudgetFrameEnd(void)
+{
+	if (texture_budget == 0 || !GetCPCore() || !GetCPCore()->nvg)
+	{
+		return;
+	}
 
-	nvgRestore(CORE->nvg);
+	const unsigned frame = CP_System_GetFrameCount();
+	while (texture_bytes > texture_budget && lru_head && lru_head->last_used != frame)
+	{
+		CP_Image_Evict(lru_head);
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -159,10 +1383,15 @@ CP_API CP_Image CP_Image_Load(const char* filepath)
 		return NULL;
 	}
 
-	// Check if the image is already loaded
-	img = CP_CheckIfImageIsLoaded(filepath);
+	// Check if the image is already loaded, that takes another reference to it
+	img = (CP_Image)CP_Asset_Acquire(CP_ASSET_IMAGE, filepath);
 	if (img)
 	{
+		// a caller of CP_Image_Load expects the image to be there
+		if (img->load)
+		{
+			CP_ImageLoad_Complete(img);
+		}
 		return img;
 	}
 
@@ -173,10 +1402,8 @@ CP_API CP_Image CP_Image_Load(const char* filepath)
 		return NULL;
 	}
 
-	strcpy_s(img->filepath, MAX_PATH, filepath);
-
 	// load the image
-	img->handle = nvgCreateImage(CORE->nvg, filepath, 0);
+	img->handle = CP_Image_CreateTexture(filepath);
 
 	if (img->handle == 0)
 	{
@@ -191,12 +1418,98 @@ CP_API CP_Image CP_Image_Load(const char* filepath)
 	nvgImageSize(CORE->nvg, img->handle, &img->w, &img->h);
 
 	img->load_error = FALSE;
+	img->flip_y = FALSE;
+	img->status = CP_IMAGE_READY;
+	img->load = NULL;
+	img->atlas = NULL;
+	img->last_used = CP_System_GetFrameCount();
+	img->evicted = FALSE;
+	img->lru_prev = img->lru_next = NULL;
+
+	if (!CP_AddImageHandle(img, filepath))
+	{
+		nvgDeleteImage(CORE->nvg, img->handle);
+		free(img);
+		return NULL;
+	}
+
+	// it can be reloaded from its path, so it can be evicted
+	texture_bytes += CP_Image_TextureBytes(img->w, img->h);
+	CP_Lru_Append(img);
+
+	return img;
+}
+
+// Returns right away with an image that draws as a placeholder until it has loaded. The file is
+// read and decoded on the job threads and uploaded over the next frames, poll
+// CP_Image_GetStatus to know when it is ready. The size is 0 until it has been decoded.
+CP_API CP_Image CP_Image_LoadAsync(const char* filepath)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!filepath || !CORE || !CORE->nvg)
+	{
+		return NULL;
+	}
+
+	// loaded or loading already, that takes another reference to it
+	CP_Image img = (CP_Image)CP_Asset_Acquire(CP_ASSET_IMAGE, filepath);
+	if (img)
+	{
+		return img;
+	}
+
+	if (!placeholder_image.handle)
+	{
+		CP_Image_CreatePlaceholder();
+	}
+
+	img = (CP_Image)malloc(sizeof(CP_Image_Struct));
+	CP_ImageLoad* load = (CP_ImageLoad*)calloc(1, sizeof(CP_ImageLoad));
+	if (!img || !load)
+	{
+		free(img);
+		free(load);
+		return NULL;
+	}
 
-	CP_AddImageHandle(img);
+	memset(img, 0, sizeof(CP_Image_Struct));
+	img->status = CP_IMAGE_LOADING;
+	img->load = load;
+	if (!CP_AddImageHandle(img, filepath))
+	{
+		free(img);
+		free(load);
+		return NULL;
+	}
+
+	load->image = img;
+	load->filepath = img->filepath;
+	CP_Pack_Find(filepath, &load->data, &load->size);
+	load->counter = CP_Job_CreateCounter();
+
+	if (load_tail)
+		load_tail->next = load;
+	else
+		load_head = load;
+	load_tail = load;
+
+	// same decode settings as nvgCreateImage, set here rather than racing on the workers
+	stbi_set_unpremultiply_on_load(1);
+	stbi_convert_iphone_png_to_rgb(1);
+	CP_Job_Submit(CP_ImageLoad_Job, load, load->counter);
 
 	return img;
 }
 
+CP_API CP_IMAGE_STATUS CP_Image_GetStatus(CP_Image img)
+{
+	if (!img)
+	{
+		return CP_IMAGE_FAILED;
+	}
+	return (CP_IMAGE_STATUS)img->status;
+}
+
 CP_API void CP_Image_Free(CP_Image* img)
 {
 	if (img == NULL || *img == NULL)
@@ -207,17 +1520,40 @@ CP_API void CP_Image_Free(CP_Image* img)
 	CP_CorePtr CORE = GetCPCore();
 	if (!CORE || !CORE->nvg) return;
 
-	for (unsigned i = 0; i < image_num; ++i)
+	// canvas images belong to their canvas
+	if ((*img)->asset == CP_ASSET_NONE)
+	{
+		return;
+	}
+
+	// an image loaded more than once stays loaded until every load has been freed
+	CP_Image image = *img;
+	*img = NULL;
+	if (CP_Asset_Release(image->asset) > 0)
+	{
+		return;
+	}
+
+	// a load in flight is dropped once its job is done
+	if (image->load)
+	{
+		image->load->image = NULL;
+	}
+	CP_Lru_Remove(image);
+	if (image->atlas)
+	{
+		CP_Atlas_Release(image->atlas);
+	}
+	else if (image->handle)
 	{
-		if (images[i] && images[i] == *img)
+		texture_bytes -= CP_Image_TextureBytes(image->w, image->h);
+		if (batch_count > 0 && batch_run.image == image->handle)
 		{
-			nvgDeleteImage(CORE->nvg, images[i]->handle); // free nanoVG's data
-			free(images[i]);
-			images[i] = NULL;
-			*img = NULL;
-			return;
+			CP_Image_FlushBatch();
 		}
+		nvgDeleteImage(CORE->nvg, image->handle); // free nanoVG's data
 	}
+	free(image);
 }
 
 CP_API int CP_Image_GetWidth(CP_Image img)
@@ -275,9 +1611,6 @@ CP_API CP_Image CP_Image_CreateFromData(int w, int h, unsigned char* pixelDataIn
 		return NULL;
 	}
 
-	char buffer[MAX_PATH] = { 0 };
-	strcpy_s(img->filepath, MAX_PATH, buffer);
-
 	// load the image
 	img->handle = nvgCreateImageRGBA(CORE->nvg, w, h, 0, pixelDataInput);
 
@@ -292,8 +1625,21 @@ CP_API CP_Image CP_Image_CreateFromData(int w, int h, unsigned char* pixelDataIn
 	img->h = h;
 
 	img->load_error = FALSE;
-
-	CP_AddImageHandle(img);
+	img->flip_y = FALSE;
+	img->status = CP_IMAGE_READY;
+	img->load = NULL;
+	img->atlas = NULL;
+	img->last_used = CP_System_GetFrameCount();
+	img->evicted = FALSE;
+	img->lru_prev = img->lru_next = NULL;
+
+	if (!CP_AddImageHandle(img, NULL))
+	{
+		nvgDeleteImage(CORE->nvg, img->handle);
+		free(img);
+		return NULL;
+	}
+	texture_bytes += CP_Image_TextureBytes(img->w, img->h);
 
 	return img;
 }
@@ -308,6 +1654,24 @@ CP_API CP_Image CP_Image_Screenshot(int x, int y, int w, int h)
 	}
 	CP_CorePtr CORE = GetCPCore();
 
+	// batched sprites are part of the frame being captured
+	CP_Image_FlushBatch();
+
+	if (CORE->isHeadless)
+	{
+		// the software framebuffer is already top down, copy the region directly
+		nvgEndFrame(CORE->nvg);
+		CP_ScreenshotHeadless(x, y, w, h, buffer);
+		nvgBeginFrame(CORE->nvg, CORE->window_width, CORE->window_height, CORE->pixel_ratio);
+
+		CP_Image headlessImg = CP_Image_CreateFromData(w, h, buffer);
+
+		free(buffer);
+		free(rowTemp);
+
+		return headlessImg;
+	}
+
 	// glReadPixles uses x,y as the lower left, so lets convert that
 	// to the top right for the sake of consistency
 	y = (CORE->window_height - h) - y;
@@ -315,7 +1679,15 @@ CP_API CP_Image CP_Image_Screenshot(int x, int y, int w, int h)
 	// flush nanovg so image can be captured
 	nvgEndFrame(CORE->nvg);
 
-	glReadPixels(x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
+	// the frame is read where it is rendered, which can be the render thread
+	CP_ReadRegion region;
+	region.x = x;
+	region.y = y;
+	region.w = w;
+	region.h = h;
+	region.buffer = buffer;
+	CP_Render_Call(CP_ReadPixelsGL, &region, sizeof(region));
+	CP_Render_Sync();
 
 	nvgBeginFrame(CORE->nvg, CORE->window_width, CORE->window_height, CORE->pixel_ratio);
 
@@ -341,6 +1713,49 @@ CP_API CP_Image CP_Image_Screenshot(int x, int y, int w, int h)
 	return newImg;
 }
 
+// Captures a top left based region of the frame once it has been drawn, without waiting for the
+// GPU. The callback runs on the main thread a frame or a few later with the pixels top down, or
+// with no pixels and a size of 0 if the capture failed. The pixels are freed after the callback.
+CP_API CP_BOOL CP_Image_ScreenshotAsync(int x, int y, int w, int h, ScreenshotFunctionPtr callback, void* userdata)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!CORE || !CORE->nvg || !callback || w <= 0 || h <= 0)
+	{
+		return FALSE;
+	}
+
+	if (!capture_lock_ready)
+	{
+		if (mtx_init(&capture_lock, mtx_plain) != thrd_success)
+		{
+			return FALSE;
+		}
+		capture_lock_ready = TRUE;
+	}
+
+	if (capture_request_count == capture_request_max)
+	{
+		int max = capture_request_max < 4 ? 4 : capture_request_max * 2;
+		CP_CaptureRequest* temp = (CP_CaptureRequest*)realloc(capture_requests, max * sizeof(CP_CaptureRequest));
+		if (!temp)
+		{
+			return FALSE;
+		}
+		capture_requests = temp;
+		capture_request_max = max;
+	}
+
+	CP_CaptureRequest* request = &capture_requests[capture_request_count++];
+	request->x = x;
+	request->y = y;
+	request->w = w;
+	request->h = h;
+	request->callback = callback;
+	request->userdata = userdata;
+	++capture_in_flight;
+	return TRUE;
+}
+
 CP_API void CP_Image_GetPixelData(CP_Image img, CP_Color* pixelDataOutput)
 {
     if (!img) return;
@@ -351,6 +1766,23 @@ CP_API void CP_Image_GetPixelData(CP_Image img, CP_Color* pixelDataOutput)
         return;
     }
 
+    if ((img->evicted && !CP_Image_ReloadSameSize(img)) || img->status != CP_IMAGE_READY)
+    {
+        return;
+    }
+
+    // a sub image is copied out of its atlas
+    if (img->atlas)
+    {
+        unsigned char* pixels = CP_Image_ReadPixels(img);
+        if (pixels)
+        {
+            memcpy(pixelDataOutput, pixels, (size_t)img->w * img->h * 4);
+            free(pixels);
+        }
+        return;
+    }
+
     nvgGetImagePixelsRGBA(CORE->nvg, img->handle, (unsigned char*)pixelDataOutput);
 }
 
@@ -364,5 +1796,115 @@ CP_API void CP_Image_UpdatePixelData(CP_Image img, CP_Color* pixelDataInput)
 		return;
 	}
 
+	// sub images share their texture with the rest of the atlas and are not updated
+	if (img->atlas || (img->evicted && !CP_Image_ReloadSameSize(img)) || img->status != CP_IMAGE_READY)
+	{
+		return;
+	}
+
+	// the new pixels can not be reloaded from the file, so it is no longer evicted
+	CP_Lru_Remove(img);
+
 	nvgUpdateImage(CORE->nvg, img->handle, (unsigned char*)pixelDataInput);
 }
+
+// Shapes and text drawn while a batch is open are not batched, they can end up underneath
+// the batched sprites which are drawn when the texture or state changes and at CP_Image_EndBatch.
+CP_API void CP_Image_BeginBatch(void)
+{
+	batch_active = TRUE;
+}
+
+CP_API void CP_Image_EndBatch(void)
+{
+	CP_Image_FlushBatch();
+	batch_active = FALSE;
+}
+
+// Packs the images into as few large textures as it takes and writes a sub image for each path
+// to subImages, NULL for the ones that could not be loaded. Sub images draw like any other image,
+// draws of ones that share a texture batch together. Returns FALSE if any of them is NULL.
+CP_API CP_BOOL CP_Image_CreateAtlas(const char** filepaths, int count, CP_Image* subImages)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!filepaths || !subImages || count <= 0 || !CORE || !CORE->nvg)
+	{
+		return FALSE;
+	}
+
+	CP_AtlasItem* items = (CP_AtlasItem*)calloc(count, sizeof(CP_AtlasItem));
+	if (!items)
+	{
+		return FALSE;
+	}
+
+	// the files are decoded on the job threads, with the same settings as nvgCreateImage
+	stbi_set_unpremultiply_on_load(1);
+	stbi_convert_iphone_png_to_rgb(1);
+	CP_AtlasDecode decode;
+	decode.filepaths = filepaths;
+	decode.items = items;
+	CP_ParallelFor(0, count, 1, CP_Atlas_DecodeRange, &decode);
+
+	CP_BOOL success = CP_Atlas_Create(items, count, subImages);
+
+	for (int i = 0; i < count; ++i)
+	{
+		stbi_image_free(items[i].pixels);
+	}
+	free(items);
+	return success;
+}
+
+// Like CP_Image_CreateAtlas with images that are already loaded. The images are copied into the
+// atlas and stay valid, free them once they are no longer needed.
+CP_API CP_BOOL CP_Image_CreateAtlasFromImages(const CP_Image* images, int count, CP_Image* subImages)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!images || !subImages || count <= 0 || !CORE || !CORE->nvg)
+	{
+		return FALSE;
+	}
+
+	CP_AtlasItem* items = (CP_AtlasItem*)calloc(count, sizeof(CP_AtlasItem));
+	if (!items)
+	{
+		return FALSE;
+	}
+
+	// batched sprites are drawn before their textures are read back
+	CP_Image_FlushBatch();
+	for (int i = 0; i < count; ++i)
+	{
+		if (images[i])
+		{
+			items[i].pixels = CP_Image_ReadPixels(images[i]);
+			items[i].w = images[i]->w;
+			items[i].h = images[i]->h;
+		}
+	}
+
+	CP_BOOL success = CP_Atlas_Create(items, count, subImages);
+
+	for (int i = 0; i < count; ++i)
+	{
+		free(items[i].pixels);
+	}
+	free(items);
+	return success;
+}
+
+// Limits the memory taken by image textures. Once they go over it, images loaded from a file that
+// were drawn least recently give up their texture at the end of the frame and load it again the
+// next time they are drawn. Images that were not loaded from a file, or whose pixels were updated,
+// are never evicted. 0 removes the budget, which is the default.
+CP_API void CP_Image_SetTextureBudget(unsigned megabytes)
+{
+	texture_budget = (size_t)megabytes * 1024 * 1024;
+}
+
+// Memory taken by image and atlas textures in megabytes, canvases and fonts are not counted
+CP_API float CP_Image_GetTextureMemory(void)
+{
+	return texture_bytes / (1024.0f * 1024.0f);
+}
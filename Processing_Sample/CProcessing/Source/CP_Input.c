@@ -11,6 +11,8 @@
 //------------------------------------------------------------------------------
 
 #include <math.h>
+#include <stdio.h>
+#include <time.h>
 #include "cprocessing.h"
 #include "Internal_System.h"
 #include <timeapi.h>
@@ -96,6 +98,27 @@ static bool gamepad_connected[XUSER_MAX_COUNT] = { false };
 static int _defaultGamepadId = -1;
 static const float _deadzone = CP_GAMEPAD_THUMB_DEADZONE / CP_GAMEPAD_THUMB_RANGE;
 
+//-------------------------------------
+// Recording and replay
+
+// Files start with the magic, version and noise seed, then one record per frame:
+//   float dt, uint32 rng[4], float mouse x and y, uint8 mouse buttons, uint8 flags,
+//   float wheel x and y (only with CP_INPUT_FRAME_WHEEL), uint16 key count and keys down,
+//   uint8 connected gamepads, XINPUT_GAMEPAD for each connected gamepad
+#define CP_INPUT_FILE_MAGIC      0x52495043 // "CPIR"
+#define CP_INPUT_FILE_VERSION    1
+#define CP_INPUT_FRAME_DOUBLE_CLICK 0x01
+#define CP_INPUT_FRAME_WHEEL        0x02
+
+static FILE* record_file = NULL;
+static FILE* replay_file = NULL;
+static int   replay_noise_seed = 0;
+static bool  replay_seeded = false;	// the noise seed is applied on the first frame
+static float replay_mouseX = 0;
+static float replay_mouseY = 0;
+static XINPUT_GAMEPAD replay_gamepads[XUSER_MAX_COUNT];
+static unsigned char  replay_gamepads_connected = 0;
+
 //------------------------------------------------------------------------------
 // Internal Functions:
 //------------------------------------------------------------------------------
@@ -174,17 +197,194 @@ void CP_Input_Init(void)
 	}
 
     CP_CorePtr CORE = GetCPCore();
-    glfwSetInputMode(CORE->window, GLFW_STICKY_MOUSE_BUTTONS, 1);
+    if (CORE->window)
+    {
+        glfwSetInputMode(CORE->window, GLFW_STICKY_MOUSE_BUTTONS, 1);
+    }
 
 	CP_Input_MouseUpdate();
 	CP_Input_MouseUpdate(); // intentionally called twice to setup curr and prev mouse values
 }
 
+static CP_BOOL CP_Input_Write(const void* data, size_t size)
+{
+	return fwrite(data, size, 1, record_file) == 1;
+}
+
+static CP_BOOL CP_Input_Read(void* data, size_t size)
+{
+	return fread(data, size, 1, replay_file) == 1;
+}
+
+static void CP_Input_StartFrame(int noiseSeed)
+{
+	// noise tables are built once from the seed, the same seed gives the same noise
+	if (!replay_seeded)
+	{
+		CP_Random_NoiseSeed(noiseSeed);
+		replay_seeded = true;
+	}
+}
+
+// Writes the state the frame is going to see, after it has been updated
+static void CP_Input_RecordFrame(void)
+{
+	CP_Input_StartFrame(replay_noise_seed);
+
+	float dt = CP_System_GetDt();
+	unsigned int rng[4];
+	CP_Random_GetState(rng);
+
+	unsigned char buttons = 0;
+	for (int i = 0; i < CP_NUM_MOUSE_BUTTONS; ++i)
+	{
+		if (mouse_states_current[i])
+		{
+			buttons = (unsigned char)(buttons | (1 << i));
+		}
+	}
+	unsigned char flags = 0;
+	if (mouse_double_clicked_current)
+	{
+		flags = (unsigned char)(flags | CP_INPUT_FRAME_DOUBLE_CLICK);
+	}
+	if (mouse_wheelx_current != 0.0f || mouse_wheely_current != 0.0f)
+	{
+		flags = (unsigned char)(flags | CP_INPUT_FRAME_WHEEL);
+	}
+
+	unsigned short keys[CP_NUM_KEYS];
+	unsigned short keyCount = 0;
+	for (unsigned short keyCode = 0; keyCode < CP_NUM_KEYS; ++keyCode)
+	{
+		if (key_states_current[keyCode])
+		{
+			keys[keyCount++] = keyCode;
+		}
+	}
+
+	unsigned char connected = 0;
+	for (int i = 0; i < XUSER_MAX_COUNT; ++i)
+	{
+		if (gamepad_connected[i])
+		{
+			connected = (unsigned char)(connected | (1 << i));
+		}
+	}
+
+	CP_BOOL written = CP_Input_Write(&dt, sizeof(dt)) && CP_Input_Write(rng, sizeof(rng)) &&
+		CP_Input_Write(&_mouseX, sizeof(_mouseX)) && CP_Input_Write(&_mouseY, sizeof(_mouseY)) &&
+		CP_Input_Write(&buttons, sizeof(buttons)) && CP_Input_Write(&flags, sizeof(flags));
+	if (written && (flags & CP_INPUT_FRAME_WHEEL))
+	{
+		written = CP_Input_Write(&mouse_wheelx_current, sizeof(float)) && CP_Input_Write(&mouse_wheely_current, sizeof(float));
+	}
+	written = written && CP_Input_Write(&keyCount, sizeof(keyCount)) &&
+		(keyCount == 0 || CP_Input_Write(keys, sizeof(keys[0]) * keyCount)) &&
+		CP_Input_Write(&connected, sizeof(connected));
+	for (int i = 0; written && i < XUSER_MAX_COUNT; ++i)
+	{
+		if (connected & (1 << i))
+		{
+			written = CP_Input_Write(&gamepad_curr_states[i].Gamepad, sizeof(XINPUT_GAMEPAD));
+		}
+	}
+
+	if (!written)
+	{
+		printf("Input recording failed, stopping.\n");
+		CP_Input_StopRecording();
+	}
+}
+
+// Reads the next frame into the realtime state, which the updates then copy as usual.
+// Returns FALSE at the end of the replay.
+static CP_BOOL CP_Input_ReplayFrame(void)
+{
+	CP_Input_StartFrame(replay_noise_seed);
+
+	float dt = 0;
+	unsigned int rng[4];
+	unsigned char buttons = 0;
+	unsigned char flags = 0;
+	float wheelX = 0.0f, wheelY = 0.0f;
+	unsigned short keys[CP_NUM_KEYS];
+	unsigned short keyCount = 0;
+	unsigned char connected = 0;
+
+	CP_BOOL read = CP_Input_Read(&dt, sizeof(dt)) && CP_Input_Read(rng, sizeof(rng)) &&
+		CP_Input_Read(&replay_mouseX, sizeof(replay_mouseX)) && CP_Input_Read(&replay_mouseY, sizeof(replay_mouseY)) &&
+		CP_Input_Read(&buttons, sizeof(buttons)) && CP_Input_Read(&flags, sizeof(flags));
+	if (read && (flags & CP_INPUT_FRAME_WHEEL))
+	{
+		read = CP_Input_Read(&wheelX, sizeof(wheelX)) && CP_Input_Read(&wheelY, sizeof(wheelY));
+	}
+	read = read && CP_Input_Read(&keyCount, sizeof(keyCount)) && keyCount <= CP_NUM_KEYS &&
+		(keyCount == 0 || CP_Input_Read(keys, sizeof(keys[0]) * keyCount)) &&
+		CP_Input_Read(&connected, sizeof(connected));
+	for (int i = 0; read && i < XUSER_MAX_COUNT; ++i)
+	{
+		if (connected & (1 << i))
+		{
+			read = CP_Input_Read(&replay_gamepads[i], sizeof(XINPUT_GAMEPAD));
+		}
+	}
+	if (!read)
+	{
+		return FALSE;
+	}
+
+	CP_SetFrameTimeInternal(dt);
+	CP_Random_SetState(rng);
+
+	memset(key_states_realtime, 0, sizeof(key_states_realtime));
+	for (unsigned short i = 0; i < keyCount; ++i)
+	{
+		if (keys[i] < CP_NUM_KEYS)
+		{
+			key_states_realtime[keys[i]] = TRUE;
+		}
+	}
+	for (int i = 0; i < CP_NUM_MOUSE_BUTTONS; ++i)
+	{
+		mouse_states_realtime[i] = (buttons & (1 << i)) ? TRUE : FALSE;
+	}
+	mouse_double_clicked_realtime = (flags & CP_INPUT_FRAME_DOUBLE_CLICK) ? TRUE : FALSE;
+	mouse_wheelx_realtime = wheelX;
+	mouse_wheely_realtime = wheelY;
+	mouse_wheel_captured = (flags & CP_INPUT_FRAME_WHEEL) ? TRUE : FALSE;
+	replay_gamepads_connected = connected;
+	return TRUE;
+}
+
 void CP_Input_Update(void)
 {
+	if (replay_file && !CP_Input_ReplayFrame())
+	{
+		// the recording is over, so is the run
+		fclose(replay_file);
+		replay_file = NULL;
+		CP_Engine_Terminate();
+	}
+
 	CP_Input_KeyboardUpdate();
 	CP_Input_MouseUpdate();
 	CP_Input_GamepadUpdate();
+
+	if (record_file)
+	{
+		CP_Input_RecordFrame();
+	}
+}
+
+void CP_Input_Shutdown(void)
+{
+	CP_Input_StopRecording();
+	if (replay_file)
+	{
+		fclose(replay_file);
+		replay_file = NULL;
+	}
 }
 
 void CP_Input_KeyboardUpdate(void)
@@ -217,13 +417,22 @@ void CP_Input_KeyboardUpdate(void)
 
 void CP_Input_MouseUpdate(void)
 {
-	double mx, my;
+	double mx = _mouseX, my = _mouseY;
 
 	// Update mouse position
 	_pmouseX = _mouseX;
 	_pmouseY = _mouseY;
 
-	glfwGetCursorPos(GetCPCore()->window, &mx, &my);
+	// headless runs have no cursor, the mouse stays where it was
+	if (replay_file)
+	{
+		mx = replay_mouseX;
+		my = replay_mouseY;
+	}
+	else if (GetCPCore()->window)
+	{
+		glfwGetCursorPos(GetCPCore()->window, &mx, &my);
+	}
 	_mouseX = (float)mx;
 	_mouseY = (float)my;
 
@@ -273,7 +482,22 @@ void CP_Input_GamepadUpdate(void)
 		memset(&gamepad_curr_states[i], 0, sizeof(XINPUT_STATE));
 		memset(&gamepad_curr_analog_states[i], 0, sizeof(CP_GAMEPAD_ANALOG_STATE));
 
-		if (XInputGetState(i, &gamepad_curr_states[i]) == 0)
+		// replays read the gamepads that were connected when recording
+		DWORD result = ERROR_DEVICE_NOT_CONNECTED;
+		if (replay_file)
+		{
+			if (replay_gamepads_connected & (1 << i))
+			{
+				gamepad_curr_states[i].Gamepad = replay_gamepads[i];
+				result = ERROR_SUCCESS;
+			}
+		}
+		else
+		{
+			result = XInputGetState(i, &gamepad_curr_states[i]);
+		}
+
+		if (result == ERROR_SUCCESS)
 		{
 			// mark connected and keep track of one default gamepad for basic function access
 			gamepad_connected[i] = true;
@@ -661,3 +885,74 @@ CP_API CP_BOOL CP_Input_GamepadConnectedAdvanced(unsigned gamepadIndex)
 {
 	return CP_Input_IsValidGamepadIndex(gamepadIndex) && gamepad_connected[gamepadIndex];
 }
+
+//-------------------------------------
+// Recording
+
+// Records the input of every frame, along with the frame time and random number state, until
+// stopped or the program ends. Start recording before CP_Engine_Run to replay a whole session.
+CP_API CP_BOOL CP_Input_StartRecording(const char* filepath)
+{
+	if (!filepath || record_file || replay_file)
+	{
+		return FALSE;
+	}
+
+	record_file = fopen(filepath, "wb");
+	if (!record_file)
+	{
+		return FALSE;
+	}
+
+	unsigned int header[2] = { CP_INPUT_FILE_MAGIC, CP_INPUT_FILE_VERSION };
+	replay_noise_seed = (int)time(NULL);
+	replay_seeded = false;
+	if (!CP_Input_Write(header, sizeof(header)) || !CP_Input_Write(&replay_noise_seed, sizeof(replay_noise_seed)))
+	{
+		CP_Input_StopRecording();
+		return FALSE;
+	}
+	return TRUE;
+}
+
+CP_API void CP_Input_StopRecording(void)
+{
+	if (record_file)
+	{
+		fclose(record_file);
+		record_file = NULL;
+	}
+}
+
+// Plays back a recording in place of the keyboard, mouse and gamepads, with every frame taking
+// the time it took when recorded and no frame rate limit. The program ends with the recording,
+// so call this before CP_Engine_Run or CP_Engine_RunHeadless for repeatable benchmark runs.
+CP_API CP_BOOL CP_Input_Replay(const char* filepath)
+{
+	if (!filepath || record_file || replay_file)
+	{
+		return FALSE;
+	}
+
+	replay_file = fopen(filepath, "rb");
+	if (!replay_file)
+	{
+		return FALSE;
+	}
+
+	unsigned int header[2] = { 0, 0 };
+	if (!CP_Input_Read(header, sizeof(header)) || header[0] != CP_INPUT_FILE_MAGIC || header[1] != CP_INPUT_FILE_VERSION ||
+		!CP_Input_Read(&replay_noise_seed, sizeof(replay_noise_seed)))
+	{
+		fclose(replay_file);
+		replay_file = NULL;
+		return FALSE;
+	}
+	replay_seeded = false;
+	return TRUE;
+}
+
+CP_API CP_BOOL CP_Input_IsReplaying(void)
+{
+	return replay_file ? TRUE : FALSE;
+}
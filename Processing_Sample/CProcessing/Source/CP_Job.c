@@ -0,0 +1,512 @@
+//------------------------------------------------------------------------------
+// file:	CP_Job.c
+// author:	Justin Chambers
+// brief:	Worker thread pool with work stealing, job counters and parallel for
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+#include "tinycthread.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+#define CP_JOB_MAX_WORKERS 63
+#define CP_JOB_QUEUE_SIZE  1024	// jobs per thread, a full queue runs new jobs right away
+#define CP_JOB_FOR_SPLIT   8	// parallel for ranges are split into this many jobs per thread
+
+#ifdef _WIN32
+#define CP_JOB_INCREMENT(value) InterlockedIncrement(value)
+#define CP_JOB_DECREMENT(value) InterlockedDecrement(value)
+#define CP_JOB_EXCHANGE(value, expected, desired) InterlockedCompareExchange(value, desired, expected)
+#define CP_JOB_LOAD(value) InterlockedCompareExchange(value, 0, 0)
+#else
+#define CP_JOB_INCREMENT(value) __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST)
+#define CP_JOB_DECREMENT(value) __atomic_sub_fetch(value, 1, __ATOMIC_SEQ_CST)
+#define CP_JOB_EXCHANGE(value, expected, desired) __sync_val_compare_and_swap(value, expected, desired)
+#define CP_JOB_LOAD(value) __atomic_load_n(value, __ATOMIC_SEQ_CST)
+#endif
+
+typedef struct CP_Job
+{
+	JobFunctionPtr function;
+	void* data;
+	CP_JobCounter counter;
+} CP_Job;
+
+// A job submitted after a counter, kept on the counter until it reaches zero
+typedef struct CP_DeferredJob
+{
+	CP_Job job;
+	struct CP_DeferredJob* next;
+} CP_DeferredJob;
+
+typedef struct CP_JobCounter_Struct
+{
+	volatile long value;		// jobs submitted with the counter that have not finished, only
+								// reaches zero while deferred_lock is held
+	CP_DeferredJob* deferred;	// guarded by deferred_lock
+} CP_JobCounter_Struct;
+
+// Each thread pushes and pops its own jobs at the bottom of its queue, idle threads steal
+// the oldest jobs from the top of the others
+typedef struct CP_JobQueue
+{
+	mtx_t lock;
+	unsigned top;
+	unsigned bottom;
+	CP_Job jobs[CP_JOB_QUEUE_SIZE];
+} CP_JobQueue;
+
+// Queue 0 belongs to the main thread and any thread outside the pool, the workers own the rest
+static CP_JobQueue* queues = NULL;
+static int queue_count = 0;
+static thrd_t workers[CP_JOB_MAX_WORKERS];
+static int worker_count = 0;
+static _Thread_local int thread_queue = 0;
+
+// Workers with nothing to do sleep until a job is queued
+static mtx_t work_lock;
+static cnd_t work_available;
+static volatile long queued_jobs = 0;
+static int quit = 0;
+
+static mtx_t deferred_lock;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+static int CP_Job_ProcessorCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+static void CP_Job_Run(CP_Job job);
+
+// Queues a job on the calling thread's queue, it runs right away when the queue is full
+static void CP_Job_Push(CP_Job job)
+{
+	if (!queues)
+	{
+		CP_Job_Run(job);
+		return;
+	}
+
+	CP_JobQueue* queue = &queues[thread_queue];
+	mtx_lock(&queue->lock);
+	if (queue->bottom - queue->top >= CP_JOB_QUEUE_SIZE)
+	{
+		mtx_unlock(&queue->lock);
+		CP_Job_Run(job);
+		return;
+	}
+	// counted before it can be taken, so a thief's decrement never runs ahead of it
+	CP_JOB_INCREMENT(&queued_jobs);
+	queue->jobs[queue->bottom % CP_JOB_QUEUE_SIZE] = job;
+	queue->bottom++;
+	mtx_unlock(&queue->lock);
+
+	mtx_lock(&work_lock);
+	cnd_signal(&work_available);
+	mtx_unlock(&work_lock);
+}
+
+// Takes the newest job of the calling thread's queue, or steals the oldest of another's
+static int CP_Job_Take(CP_Job* job)
+{
+	for (int i = 0; i < queue_count; ++i)
+	{
+		int index = (thread_queue + i) % queue_count;
+		CP_JobQueue* queue = &queues[index];
+		int taken = 0;
+
+		mtx_lock(&queue->lock);
+		if (queue->bottom != queue->top)
+		{
+			if (i == 0)
+			{
+				queue->bottom--;
+				*job = queue->jobs[queue->bottom % CP_JOB_QUEUE_SIZE];
+			}
+			else
+			{
+				*job = queue->jobs[queue->top % CP_JOB_QUEUE_SIZE];
+				queue->top++;
+			}
+			taken = 1;
+		}
+		mtx_unlock(&queue->lock);
+
+		if (taken)
+		{
+			CP_JOB_DECREMENT(&queued_jobs);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// Runs a job and releases what was waiting on its counter when it is the last one
+static void CP_Job_Run(CP_Job job)
+{
+	job.function(job.data);
+
+	CP_JobCounter counter = job.counter;
+	if (!counter)
+	{
+		return;
+	}
+
+	// the counter can be freed as soon as it reads zero, so it is only brought to zero while
+	// holding the lock that CP_Job_Wait takes before returning
+	long value = CP_JOB_LOAD(&counter->value);
+	while (value > 1)
+	{
+		long previous = CP_JOB_EXCHANGE(&counter->value, value, value - 1);
+		if (previous == value)
+		{
+			return;
+		}
+		value = previous;
+	}
+
+	// without the pool there is no other thread and no lock, before init or after shutdown
+	if (!queues)
+	{
+		CP_JOB_DECREMENT(&counter->value);
+		return;
+	}
+
+	// the last job of the counter starts the jobs that were waiting for it
+	mtx_lock(&deferred_lock);
+	CP_JOB_DECREMENT(&counter->value);
+	CP_DeferredJob* deferred = counter->deferred;
+	counter->deferred = NULL;
+	mtx_unlock(&deferred_lock);
+
+	while (deferred)
+	{
+		CP_DeferredJob* next = deferred->next;
+		CP_Job_Push(deferred->job);
+		free(deferred);
+		deferred = next;
+	}
+}
+
+// Runs one queued job if there is any
+static int CP_Job_RunOne(void)
+{
+	CP_Job job;
+	if (!queues || !CP_Job_Take(&job))
+	{
+		return 0;
+	}
+	CP_Job_Run(job);
+	return 1;
+}
+
+static int CP_Job_WorkerMain(void* arg)
+{
+	thread_queue = (int)(size_t)arg;
+
+	for (;;)
+	{
+		if (CP_Job_RunOne())
+		{
+			continue;
+		}
+
+		mtx_lock(&work_lock);
+		while (CP_JOB_LOAD(&queued_jobs) == 0 && !quit)
+		{
+			cnd_wait(&work_available, &work_lock);
+		}
+		int done = CP_JOB_LOAD(&queued_jobs) == 0 && quit;
+		mtx_unlock(&work_lock);
+
+		if (done)
+		{
+			break;
+		}
+	}
+	return 0;
+}
+
+// Starts one worker per processor besides the main thread, which helps while it waits
+void CP_Job_Init(void)
+{
+	if (queues)
+	{
+		return;
+	}
+
+	int count = CP_Job_ProcessorCount() - 1;
+	count = count < 0 ? 0 : count > CP_JOB_MAX_WORKERS ? CP_JOB_MAX_WORKERS : count;
+
+	queues = (CP_JobQueue*)calloc((size_t)count + 1, sizeof(CP_JobQueue));
+	if (!queues)
+	{
+		return;
+	}
+	queue_count = count + 1;
+	for (int i = 0; i < queue_count; ++i)
+	{
+		mtx_init(&queues[i].lock, mtx_plain);
+	}
+	mtx_init(&work_lock, mtx_plain);
+	mtx_init(&deferred_lock, mtx_plain);
+	cnd_init(&work_available);
+	quit = 0;
+
+	for (worker_count = 0; worker_count < count; ++worker_count)
+	{
+		if (thrd_create(&workers[worker_count], CP_Job_WorkerMain, (void*)(size_t)(worker_count + 1)) != thrd_success)
+		{
+			break;
+		}
+	}
+}
+
+// Finishes the queued jobs and stops the workers
+void CP_Job_Shutdown(void)
+{
+	if (!queues)
+	{
+		return;
+	}
+
+	mtx_lock(&work_lock);
+	quit = 1;
+	cnd_broadcast(&work_available);
+	mtx_unlock(&work_lock);
+
+	for (int i = 0; i < worker_count; ++i)
+	{
+		thrd_join(workers[i], NULL);
+	}
+	worker_count = 0;
+
+	// the main thread's jobs are left when there were no workers to take them
+	while (CP_Job_RunOne())
+	{
+	}
+
+	for (int i = 0; i < queue_count; ++i)
+	{
+		mtx_destroy(&queues[i].lock);
+	}
+	free(queues);
+	queues = NULL;
+	queue_count = 0;
+
+	cnd_destroy(&work_available);
+	mtx_destroy(&deferred_lock);
+	mtx_destroy(&work_lock);
+}
+
+typedef struct CP_ParallelForRange
+{
+	ParallelForFunctionPtr function;
+	void* userdata;
+	int begin;
+	int end;
+} CP_ParallelForRange;
+
+static void CP_ParallelFor_Job(void* data)
+{
+	CP_ParallelForRange* range = (CP_ParallelForRange*)data;
+	range->function(range->begin, range->end, range->userdata);
+}
+
+//------------------------------------------------------------------------------
+// Library Functions:
+//------------------------------------------------------------------------------
+
+CP_API CP_JobCounter CP_Job_CreateCounter(void)
+{
+	return (CP_JobCounter)calloc(1, sizeof(CP_JobCounter_Struct));
+}
+
+// Waits for the counter's jobs before freeing it
+CP_API void CP_Job_FreeCounter(CP_JobCounter* counter)
+{
+	if (counter == NULL || *counter == NULL)
+	{
+		return;
+	}
+
+	CP_Job_Wait(*counter);
+	free(*counter);
+	*counter = NULL;
+}
+
+// Queues a job to run on any thread of the pool. The counter, which can be NULL, counts
+// the job until it has finished. Jobs run right away on the calling thread before the
+// engine is initialized.
+CP_API void CP_Job_Submit(JobFunctionPtr job, void* data, CP_JobCounter counter)
+{
+	if (!job)
+	{
+		return;
+	}
+
+	CP_Job entry;
+	entry.function = job;
+	entry.data = data;
+	entry.counter = counter;
+	if (counter)
+	{
+		CP_JOB_INCREMENT(&counter->value);
+	}
+	CP_Job_Push(entry);
+}
+
+// Queues a job that starts once every job counted by dependency has finished
+CP_API void CP_Job_SubmitAfter(CP_JobCounter dependency, JobFunctionPtr job, void* data, CP_JobCounter counter)
+{
+	if (!job)
+	{
+		return;
+	}
+	if (!dependency || !queues)
+	{
+		CP_Job_Wait(dependency);
+		CP_Job_Submit(job, data, counter);
+		return;
+	}
+
+	CP_DeferredJob* deferred = (CP_DeferredJob*)malloc(sizeof(CP_DeferredJob));
+	if (!deferred)
+	{
+		CP_Job_Wait(dependency);
+		CP_Job_Submit(job, data, counter);
+		return;
+	}
+	deferred->job.function = job;
+	deferred->job.data = data;
+	deferred->job.counter = counter;
+	if (counter)
+	{
+		CP_JOB_INCREMENT(&counter->value);
+	}
+
+	// the last job of the dependency takes the deferred jobs under the same lock, so the
+	// job is either queued here or picked up there
+	mtx_lock(&deferred_lock);
+	if (CP_JOB_LOAD(&dependency->value) != 0)
+	{
+		deferred->next = dependency->deferred;
+		dependency->deferred = deferred;
+		deferred = NULL;
+	}
+	mtx_unlock(&deferred_lock);
+
+	if (deferred)
+	{
+		CP_Job_Push(deferred->job);
+		free(deferred);
+	}
+}
+
+// Runs queued jobs on the calling thread until the counter's jobs have finished
+CP_API void CP_Job_Wait(CP_JobCounter counter)
+{
+	if (!counter)
+	{
+		return;
+	}
+
+	while (CP_JOB_LOAD(&counter->value) != 0)
+	{
+		if (!CP_Job_RunOne())
+		{
+			thrd_yield();
+		}
+	}
+
+	// the job that finished the counter can still be releasing what waited on it
+	if (queues)
+	{
+		mtx_lock(&deferred_lock);
+		mtx_unlock(&deferred_lock);
+	}
+}
+
+CP_API CP_BOOL CP_Job_IsDone(CP_JobCounter counter)
+{
+	return !counter || CP_JOB_LOAD(&counter->value) == 0 ? TRUE : FALSE;
+}
+
+// Threads that run jobs, the workers and the main thread
+CP_API int CP_Job_GetThreadCount(void)
+{
+	return worker_count + 1;
+}
+
+// Calls fn over [begin, end) split into ranges of at least grain indices and returns once
+// every range is done. A grain of 0 or less picks one from the number of threads.
+CP_API void CP_ParallelFor(int begin, int end, int grain, ParallelForFunctionPtr fn, void* userdata)
+{
+	if (!fn || end <= begin)
+	{
+		return;
+	}
+
+	const int count = end - begin;
+	const int splits = CP_Job_GetThreadCount() * CP_JOB_FOR_SPLIT;
+	int size = (count + splits - 1) / splits;
+	size = size > grain ? size : grain;
+	if (size >= count || worker_count == 0)
+	{
+		fn(begin, end, userdata);
+		return;
+	}
+
+	const int jobs = (count + size - 1) / size;
+	CP_ParallelForRange* ranges = (CP_ParallelForRange*)malloc(sizeof(CP_ParallelForRange) * (size_t)jobs);
+	if (!ranges)
+	{
+		fn(begin, end, userdata);
+		return;
+	}
+
+	CP_JobCounter_Struct counter;
+	memset(&counter, 0, sizeof(counter));
+	for (int i = 0; i < jobs; ++i)
+	{
+		ranges[i].function = fn;
+		ranges[i].userdata = userdata;
+		ranges[i].begin = begin + i * size;
+		ranges[i].end = i == jobs - 1 ? end : begin + (i + 1) * size;
+	}
+
+	// the first range runs here, the rest are picked up by the workers in the meantime
+	for (int i = 1; i < jobs; ++i)
+	{
+		CP_Job_Submit(CP_ParallelFor_Job, &ranges[i], &counter);
+	}
+	CP_ParallelFor_Job(&ranges[0]);
+	CP_Job_Wait(&counter);
+
+	free(ranges);
+}
@@ -12,6 +12,7 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <string.h>
 #include "cprocessing.h"
 #include "nanovg.h"
 #include "Internal_System.h"
@@ -20,10 +21,107 @@
 // Defines and Internal Variables:
 //------------------------------------------------------------------------------
 
+#define CP_CULL_SCREEN_MARGIN 2.0f	// pixels kept around the screen for antialiased edges
+
+// The visible part of the world under the last transform culled against, it only
+// changes with the transform or the size of what is drawn into
+static float cull_width = 0;
+static float cull_height = 0;
+static float cull_xform[6] = { 0 };
+static float cull_bounds[4] = { 0 };	// min x, min y, max x, max y
+static int cull_state = 0;				// 0 stale, 1 valid, -1 the transform can't be inverted
+static unsigned cull_count = 0;
+static unsigned cull_last_count = 0;
+
 //------------------------------------------------------------------------------
 // Internal Functions:
 //------------------------------------------------------------------------------
 
+// Maps the screen back into the world with the inverse of the transform, a rotated
+// screen is covered by the bounding box of its corners
+static void CP_Cull_UpdateBounds(const float* xform)
+{
+	memcpy(cull_xform, xform, sizeof(cull_xform));
+
+	float inverse[6];
+	if (!nvgTransformInverse(inverse, xform))
+	{
+		cull_state = -1;
+		return;
+	}
+
+	const float corners[8] = {
+		-CP_CULL_SCREEN_MARGIN, -CP_CULL_SCREEN_MARGIN,
+		cull_width + CP_CULL_SCREEN_MARGIN, -CP_CULL_SCREEN_MARGIN,
+		cull_width + CP_CULL_SCREEN_MARGIN, cull_height + CP_CULL_SCREEN_MARGIN,
+		-CP_CULL_SCREEN_MARGIN, cull_height + CP_CULL_SCREEN_MARGIN
+	};
+	for (int i = 0; i < 4; ++i)
+	{
+		float x, y;
+		nvgTransformPoint(&x, &y, inverse, corners[i * 2], corners[i * 2 + 1]);
+		cull_bounds[0] = i == 0 || x < cull_bounds[0] ? x : cull_bounds[0];
+		cull_bounds[1] = i == 0 || y < cull_bounds[1] ? y : cull_bounds[1];
+		cull_bounds[2] = i == 0 || x > cull_bounds[2] ? x : cull_bounds[2];
+		cull_bounds[3] = i == 0 || y > cull_bounds[3] ? y : cull_bounds[3];
+	}
+	cull_state = 1;
+}
+
+void CP_Cull_FrameStart(float width, float height)
+{
+	cull_last_count = cull_count;
+	cull_count = 0;
+	CP_Cull_SetViewport(width, height);
+}
+
+// The size of the screen or canvas being drawn into
+void CP_Cull_SetViewport(float width, float height)
+{
+	cull_width = width;
+	cull_height = height;
+	cull_state = 0;
+}
+
+// TRUE when the rectangle, grown by margin on every side, is entirely off screen under
+// the current transform. The corners can be given in any order. Conservative, anything
+// that might be visible is not culled.
+CP_BOOL CP_Cull_Rect(float x0, float y0, float x1, float y1, float margin)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!CORE || !CORE->nvg)
+	{
+		return FALSE;
+	}
+
+	float xform[6];
+	nvgCurrentTransform(CORE->nvg, xform);
+	if (cull_state == 0 || memcmp(xform, cull_xform, sizeof(xform)) != 0)
+	{
+		CP_Cull_UpdateBounds(xform);
+	}
+	if (cull_state < 0)
+	{
+		return FALSE;
+	}
+
+	const float minX = (x0 < x1 ? x0 : x1) - margin;
+	const float minY = (y0 < y1 ? y0 : y1) - margin;
+	const float maxX = (x0 < x1 ? x1 : x0) + margin;
+	const float maxY = (y0 < y1 ? y1 : y0) + margin;
+	if (maxX < cull_bounds[0] || maxY < cull_bounds[1] || minX > cull_bounds[2] || minY > cull_bounds[3])
+	{
+		++cull_count;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+unsigned CP_Cull_GetLastFrameCount(void)
+{
+	return cull_last_count;
+}
+
 //------------------------------------------------------------------------------
 // Library Functions:
 //------------------------------------------------------------------------------
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+// file:	CP_Pack.c
+// author:	Justin Chambers
+// brief:	Memory mapped .cpak asset packs that images, sounds and fonts load from
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+#include "Internal_Pack.h"
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+#define CP_PACK_MAX_OPEN 8
+
+typedef struct CP_Pack
+{
+	const unsigned char* view;		// the whole file, mapped read only
+	uint64_t size;
+	const CP_PackEntry* entries;
+	const char* names;
+	uint32_t count;
+} CP_Pack;
+
+static CP_Pack packs[CP_PACK_MAX_OPEN];
+static int pack_count = 0;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+// Checks that the table and every file it points to are inside the pack
+static CP_BOOL CP_Pack_Validate(CP_Pack* pack)
+{
+	if (pack->size < sizeof(CP_PackHeader))
+	{
+		return FALSE;
+	}
+
+	const CP_PackHeader* header = (const CP_PackHeader*)pack->view;
+	if (header->magic != CP_PACK_MAGIC || header->version != CP_PACK_VERSION)
+	{
+		return FALSE;
+	}
+
+	const uint64_t tableEnd = sizeof(CP_PackHeader) + (uint64_t)header->count * sizeof(CP_PackEntry);
+	const uint64_t namesEnd = tableEnd + header->names_size;
+	if (namesEnd > pack->size || (header->names_size > 0 && pack->view[namesEnd - 1] != '\0'))
+	{
+		return FALSE;
+	}
+
+	pack->entries = (const CP_PackEntry*)(pack->view + sizeof(CP_PackHeader));
+	pack->names = (const char*)(pack->view + tableEnd);
+	pack->count = header->count;
+
+	for (uint32_t i = 0; i < pack->count; ++i)
+	{
+		const CP_PackEntry* entry = &pack->entries[i];
+		if (entry->name >= header->names_size || entry->offset > pack->size || entry->size > pack->size - entry->offset)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+static void CP_Pack_Unmap(CP_Pack* pack)
+{
+	if (pack->view)
+	{
+		UnmapViewOfFile(pack->view);
+	}
+	memset(pack, 0, sizeof(CP_Pack));
+}
+
+// Binary searches the sorted table for the first entry with the hash, then compares the paths
+static const CP_PackEntry* CP_Pack_Lookup(const CP_Pack* pack, const char* path, uint32_t hash)
+{
+	uint32_t first = 0;
+	uint32_t count = pack->count;
+	while (count > 0)
+	{
+		uint32_t half = count / 2;
+		if (pack->entries[first + half].hash < hash)
+		{
+			first += half + 1;
+			count -= half + 1;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+
+	for (uint32_t i = first; i < pack->count && pack->entries[i].hash == hash; ++i)
+	{
+		if (!strcmp(pack->names + pack->entries[i].name, path))
+		{
+			return &pack->entries[i];
+		}
+	}
+	return NULL;
+}
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+void CP_Pack_Shutdown(void)
+{
+	for (int i = 0; i < pack_count; ++i)
+	{
+		CP_Pack_Unmap(&packs[i]);
+	}
+	pack_count = 0;
+}
+
+int CP_Pack_Find(const char* filepath, const unsigned char** data, unsigned* size)
+{
+	if (pack_count == 0 || !filepath || strlen(filepath) >= CP_PACK_MAX_PATH)
+	{
+		return FALSE;
+	}
+
+	char path[CP_PACK_MAX_PATH];
+	uint32_t hash = CP_Pack_NormalizePath(filepath, path);
+
+	// packs opened later override the ones before them
+	for (int i = pack_count - 1; i >= 0; --i)
+	{
+		const CP_PackEntry* entry = CP_Pack_Lookup(&packs[i], path, hash);
+		if (entry)
+		{
+			*data = packs[i].view + entry->offset;
+			*size = (unsigned)entry->size;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+//------------------------------------------------------------------------------
+// Library Functions:
+//------------------------------------------------------------------------------
+
+// Maps a .cpak made by Tools/cpak.c. Images, sounds and fonts whose path is in an open pack are
+// loaded from it without reading the file, anything else is still loaded from disk. Packs stay
+// open until the program ends, open them before loading what is in them.
+CP_API CP_BOOL CP_Pack_Open(const char* filepath)
+{
+	if (!filepath || pack_count == CP_PACK_MAX_OPEN)
+	{
+		return FALSE;
+	}
+
+	HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return FALSE;
+	}
+
+	CP_Pack pack;
+	memset(&pack, 0, sizeof(CP_Pack));
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+	{
+		// the view keeps the mapping alive once both handles are closed
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping)
+		{
+			pack.view = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			pack.size = (uint64_t)size.QuadPart;
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+
+	if (!pack.view || !CP_Pack_Validate(&pack))
+	{
+		CP_Pack_Unmap(&pack);
+		return FALSE;
+	}
+
+	packs[pack_count++] = pack;
+	return TRUE;
+}
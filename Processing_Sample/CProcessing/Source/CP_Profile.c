@@ -0,0 +1,280 @@
+//------------------------------------------------------------------------------
+// file:	CP_Profile.c
+// author:	Justin Chambers
+// brief:	Scoped timing zones written out as Chrome trace_event JSON
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+#include "tinycthread.h"
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+#define CP_PROFILE_MAX_THREADS 64
+#define CP_PROFILE_MAX_DEPTH   64
+#define CP_PROFILE_RING_SIZE   (1 << 15)	// zones kept per thread, must be a power of two
+
+// Orders zone writes against the ring head between the recording and dumping threads,
+// x86 and x64 only need the compiler to keep the accesses in order
+#if defined(_M_ARM) || defined(_M_ARM64)
+#define CP_PROFILE_BARRIER() MemoryBarrier()
+#elif defined(_MSC_VER)
+#define CP_PROFILE_BARRIER() _ReadWriteBarrier()
+#else
+#define CP_PROFILE_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+typedef struct CP_ProfileZone
+{
+	const char* name;
+	long long start;
+	long long end;
+} CP_ProfileZone;
+
+// Zones are only written by the thread that owns the ring, completed zones are
+// published by advancing head so other threads can read them without locking
+typedef struct CP_ProfileRing
+{
+	volatile unsigned head;
+	unsigned long thread_id;
+	int depth;
+	CP_ProfileZone open[CP_PROFILE_MAX_DEPTH];
+	CP_ProfileZone zones[CP_PROFILE_RING_SIZE];
+} CP_ProfileRing;
+
+static CP_ProfileRing* volatile rings[CP_PROFILE_MAX_THREADS];
+static volatile long ring_count = 0;
+static _Thread_local CP_ProfileRing* thread_ring = NULL;
+static _Thread_local int thread_ring_failed = 0;
+
+// frames slower than this are dumped to budget_path, 0 when not set
+static long long budget_ticks = 0;
+static char budget_path[MAX_PATH] = { 0 };
+static long long frame_start = 0;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+static long long CP_Profile_Ticks(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return counter.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+#endif
+}
+
+static double CP_Profile_TicksPerMicrosecond(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return (double)frequency.QuadPart / 1000000.0;
+#else
+	return 1000.0;
+#endif
+}
+
+static unsigned long CP_Profile_ThreadId(void)
+{
+#ifdef _WIN32
+	return GetCurrentThreadId();
+#else
+	return (unsigned long)thrd_current();
+#endif
+}
+
+// Creates the calling thread's ring the first time it records a zone
+static CP_ProfileRing* CP_Profile_GetRing(void)
+{
+	if (thread_ring || thread_ring_failed)
+	{
+		return thread_ring;
+	}
+
+#ifdef _WIN32
+	long slot = InterlockedIncrement(&ring_count) - 1;
+#else
+	long slot = __atomic_add_fetch(&ring_count, 1, __ATOMIC_SEQ_CST) - 1;
+#endif
+	CP_ProfileRing* ring = NULL;
+	if (slot < CP_PROFILE_MAX_THREADS)
+	{
+		ring = (CP_ProfileRing*)calloc(1, sizeof(CP_ProfileRing));
+	}
+	if (!ring)
+	{
+		thread_ring_failed = 1;
+		return NULL;
+	}
+
+	ring->thread_id = CP_Profile_ThreadId();
+	rings[slot] = ring;
+	thread_ring = ring;
+	return ring;
+}
+
+static void CP_Profile_WriteName(FILE* file, const char* name)
+{
+	for (; *name; ++name)
+	{
+		if (*name == '"' || *name == '\\')
+		{
+			fputc('\\', file);
+		}
+		if ((unsigned char)*name >= 0x20)
+		{
+			fputc(*name, file);
+		}
+	}
+}
+
+void CP_Profile_FrameStart(void)
+{
+	frame_start = CP_Profile_Ticks();
+	CP_Profile_Begin("Frame");
+}
+
+// Ends the frame zone before the frame rate sleep, so the budget only covers the frame's work
+void CP_Profile_FrameEnd(void)
+{
+	CP_Profile_End();
+
+	if (budget_ticks > 0 && CP_Profile_Ticks() - frame_start > budget_ticks)
+	{
+		budget_ticks = 0;
+		CP_Profile_Dump(budget_path);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Library Functions:
+//------------------------------------------------------------------------------
+
+// Zones nest per thread and are closed by CP_Profile_End in reverse order. The name is
+// stored rather than copied, it must stay valid until the profile is dumped (a string
+// literal is the usual choice).
+CP_API void CP_Profile_Begin(const char* name)
+{
+	CP_ProfileRing* ring = CP_Profile_GetRing();
+	if (!ring)
+	{
+		return;
+	}
+
+	// zones nested too deeply are not recorded but still have to be ended
+	if (ring->depth < CP_PROFILE_MAX_DEPTH)
+	{
+		CP_ProfileZone* zone = &ring->open[ring->depth];
+		zone->name = name ? name : "";
+		zone->start = CP_Profile_Ticks();
+	}
+	ring->depth++;
+}
+
+CP_API void CP_Profile_End(void)
+{
+	CP_ProfileRing* ring = thread_ring;
+	if (!ring || ring->depth == 0)
+	{
+		return;
+	}
+
+	ring->depth--;
+	if (ring->depth < CP_PROFILE_MAX_DEPTH)
+	{
+		CP_ProfileZone* zone = &ring->zones[ring->head & (CP_PROFILE_RING_SIZE - 1)];
+		zone->name = ring->open[ring->depth].name;
+		zone->start = ring->open[ring->depth].start;
+		zone->end = CP_Profile_Ticks();
+
+		CP_PROFILE_BARRIER();
+		ring->head = ring->head + 1;
+	}
+}
+
+// Writes the most recent zones of every thread as a Chrome trace, open it with
+// chrome://tracing or ui.perfetto.dev. Zones still open are not included.
+CP_API CP_BOOL CP_Profile_Dump(const char* filepath)
+{
+	if (!filepath)
+	{
+		return FALSE;
+	}
+
+	FILE* file = fopen(filepath, "w");
+	if (!file)
+	{
+		return FALSE;
+	}
+
+	const double ticksPerMicrosecond = CP_Profile_TicksPerMicrosecond();
+	const long count = ring_count < CP_PROFILE_MAX_THREADS ? ring_count : CP_PROFILE_MAX_THREADS;
+	int first = 1;
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+	for (long r = 0; r < count; ++r)
+	{
+		CP_ProfileRing* ring = rings[r];
+		if (!ring)
+		{
+			continue;
+		}
+
+		// the owning thread can keep recording while its zones are written out, anything
+		// it may have overwritten by the time a zone was copied is skipped
+		unsigned head = ring->head;
+		CP_PROFILE_BARRIER();
+		unsigned tail = head > CP_PROFILE_RING_SIZE ? head - CP_PROFILE_RING_SIZE : 0;
+		for (unsigned i = tail; i < head; ++i)
+		{
+			CP_ProfileZone zone = ring->zones[i & (CP_PROFILE_RING_SIZE - 1)];
+			CP_PROFILE_BARRIER();
+			if (ring->head - i >= CP_PROFILE_RING_SIZE)
+			{
+				continue;
+			}
+
+			fputs(first ? "\n{\"name\":\"" : ",\n{\"name\":\"", file);
+			CP_Profile_WriteName(file, zone.name);
+			fprintf(file, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+				ring->thread_id, (double)zone.start / ticksPerMicrosecond, (double)(zone.end - zone.start) / ticksPerMicrosecond);
+			first = 0;
+		}
+	}
+	fputs("\n]}\n", file);
+
+	CP_BOOL written = ferror(file) ? FALSE : TRUE;
+	fclose(file);
+	return written;
+}
+
+// The profile is dumped to filepath at the end of the first frame that takes longer
+// than the budget, call again to catch the next one. A budget of 0 turns this off.
+CP_API void CP_Profile_SetFrameBudget(float milliseconds, const char* filepath)
+{
+	if (milliseconds <= 0 || !filepath)
+	{
+		budget_ticks = 0;
+		return;
+	}
+
+	budget_ticks = (long long)(milliseconds * 1000.0 * CP_Profile_TicksPerMicrosecond());
+	strcpy_s(budget_path, MAX_PATH, filepath);
+}
@@ -71,6 +71,31 @@ void CP_Random_Init(void)
 	CP_Random_Seed((int)time(NULL));
 }
 
+// The generator's state, saved and restored by input recordings
+void CP_Random_GetState(unsigned int out[4])
+{
+#ifdef USE_XORSHIFT
+	for (unsigned index = 0; index < 4; ++index)
+	{
+		out[index] = state[index];
+	}
+#else
+	out[0] = out[1] = out[2] = out[3] = 0;
+#endif
+}
+
+void CP_Random_SetState(const unsigned int in[4])
+{
+#ifdef USE_XORSHIFT
+	for (unsigned index = 0; index < 4; ++index)
+	{
+		state[index] = in[index];
+	}
+#else
+	(void)in;
+#endif
+}
+
 //------------------------------------------------------------------------------
 // Library Functions:
 //------------------------------------------------------------------------------
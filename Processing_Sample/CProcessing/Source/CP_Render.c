@@ -0,0 +1,395 @@
+//------------------------------------------------------------------------------
+// file:	CP_Render.c
+// author:	Justin Chambers
+// brief:	Render thread that replays the game thread's drawing on the GL context
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <string.h>
+#include "cprocessing.h"
+#include "Internal_System.h"
+#include "tinycthread.h"
+#include "nanovg_gl_utils.h"
+#define NANOVG_QUEUE_IMPLEMENTATION
+#include "nanovg_queue.h"
+
+// nanovg_gl.h is compiled with the implementation in CP_System.c
+int nvglDrawCountGL3(NVGcontext* ctx);
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+// The context rendering to GL. When threaded the game thread draws with a queue context
+// instead, one frame is recorded while the render thread renders the one before it.
+static NVGcontext* render_context = NULL;
+static NVGcontext* queue_context = NULL;
+
+static thrd_t render_thread;
+static mtx_t render_lock;
+static cnd_t render_wake;			// signaled when a frame is submitted or on shutdown
+static cnd_t render_done;			// signaled when the submitted frame has been rendered
+static int render_running = 0;
+static int render_pending = 0;		// a submitted frame is waiting for or being rendered
+static int render_quit = 0;
+
+// Frames the GPU can be behind by, each presented frame is fenced and the oldest fence is
+// waited on once there are this many. Only touched where the GL context is current.
+#define CP_MAX_FRAMES_IN_FLIGHT 3
+#define CP_FENCE_TIMEOUT 1000000000ull	// nanoseconds, a stuck fence is given up on
+static unsigned frames_in_flight = 2;
+static GLsync frame_fences[CP_MAX_FRAMES_IN_FLIGHT];
+static unsigned fence_count = 0;
+
+// GL draw calls of the last presented frame, written where the GL context is current
+static volatile int frame_draw_calls = 0;
+
+// The screen is drawn into this framebuffer and copied to the window's back buffer when
+// presented, so what was drawn stays on screen between frames the way it did single buffered.
+// NULL when it could not be created, the back buffer is drawn into directly then.
+static NVGLUframebuffer* screen_framebuffer = NULL;
+static int screen_width = 0;
+static int screen_height = 0;
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+static int CP_Render_ThreadMain(void* arg)
+{
+	(void)arg;
+	glfwMakeContextCurrent(GetCPCore()->window);
+
+	mtx_lock(&render_lock);
+	for (;;)
+	{
+		while (!render_pending && !render_quit)
+		{
+			cnd_wait(&render_wake, &render_lock);
+		}
+		if (!render_pending)
+		{
+			break;
+		}
+		mtx_unlock(&render_lock);
+
+		CP_Profile_Begin("RenderThread");
+		nvgqueueExecute(queue_context, render_context);
+		CP_Profile_End();
+
+		mtx_lock(&render_lock);
+		render_pending = 0;
+		cnd_broadcast(&render_done);
+	}
+	mtx_unlock(&render_lock);
+
+	glfwMakeContextCurrent(NULL);
+	return 0;
+}
+
+// Waits for the render thread to finish the submitted frame
+static void CP_Render_Wait(void)
+{
+	mtx_lock(&render_lock);
+	while (render_pending)
+	{
+		cnd_wait(&render_done, &render_lock);
+	}
+	mtx_unlock(&render_lock);
+}
+
+// Hands everything recorded so far to the render thread, or renders it on this thread
+// while there is no render thread
+static void CP_Render_Submit(void)
+{
+	if (!render_running)
+	{
+		nvgqueueSubmit(queue_context);
+		nvgqueueExecute(queue_context, render_context);
+		return;
+	}
+
+	CP_Render_Wait();
+	nvgqueueSubmit(queue_context);
+
+	mtx_lock(&render_lock);
+	render_pending = 1;
+	cnd_signal(&render_wake);
+	mtx_unlock(&render_lock);
+}
+
+static void CP_Render_SyncCallback(void* user)
+{
+	(void)user;
+	CP_Render_Sync();
+}
+
+// Waits for the GPU to finish the oldest fenced frame
+static void CP_Render_WaitFence(void)
+{
+	CP_Profile_Begin("WaitGPU");
+	glClientWaitSync(frame_fences[0], GL_SYNC_FLUSH_COMMANDS_BIT, CP_FENCE_TIMEOUT);
+	glDeleteSync(frame_fences[0]);
+	CP_Profile_End();
+
+	--fence_count;
+	memmove(&frame_fences[0], &frame_fences[1], sizeof(GLsync) * fence_count);
+}
+
+static void CP_Render_SwapBuffers(void* data)
+{
+	(void)data;
+	frame_draw_calls = nvglDrawCountGL3(render_context);
+
+	CP_Profile_Begin("SwapBuffers");
+	if (screen_framebuffer)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, screen_framebuffer->fbo);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, screen_width, screen_height, 0, 0, screen_width, screen_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+	glfwSwapBuffers(GetCPCore()->window);
+	CP_Render_BindScreen();
+	CP_Profile_End();
+
+	// fences need GL 3.2, without them the driver decides how far ahead the CPU gets
+	if (!GLAD_GL_VERSION_3_2)
+	{
+		return;
+	}
+	frame_fences[fence_count++] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	while (fence_count >= frames_in_flight)
+	{
+		CP_Render_WaitFence();
+	}
+}
+
+static void CP_Render_ApplyVSync(void* data)
+{
+	CP_VSYNC_MODE mode = *(const CP_VSYNC_MODE*)data;
+	int interval = 0;
+	if (mode == CP_VSYNC_ON)
+	{
+		interval = 1;
+	}
+	else if (mode == CP_VSYNC_ADAPTIVE)
+	{
+		// a negative interval tears late frames instead of holding them for another refresh
+		interval = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+			glfwExtensionSupported("GLX_EXT_swap_control_tear") ? -1 : 1;
+	}
+	glfwSwapInterval(interval);
+}
+
+// Replaces the screen framebuffer with one of the new size, cleared to black
+static void CP_Render_ResizeScreen(void* data)
+{
+	const int* size = (const int*)data;
+	if (screen_framebuffer && screen_width == size[0] && screen_height == size[1])
+	{
+		return;
+	}
+
+	if (screen_framebuffer)
+	{
+		nvgluDeleteFramebuffer(screen_framebuffer);
+	}
+	screen_framebuffer = nvgluCreateFramebuffer(render_context, size[0], size[1], 0);
+	screen_width = size[0];
+	screen_height = size[1];
+	if (!screen_framebuffer)
+	{
+		printf("Could not create the screen framebuffer, drawing to the back buffer.\n");
+	}
+
+	CP_Render_BindScreen();
+	glClearColor(0, 0, 0, 1);
+	glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+static void CP_Render_ApplyFramesInFlight(void* data)
+{
+	frames_in_flight = *(const unsigned*)data;
+	while (fence_count > 0 && fence_count >= frames_in_flight)
+	{
+		CP_Render_WaitFence();
+	}
+}
+
+// Replaces the GL context the engine draws with by a queue context when threaded,
+// called once the GL context has been created
+void CP_Render_Init(void)
+{
+	CP_CorePtr CORE = GetCPCore();
+	render_context = CORE->nvg;
+	if (!CORE->isThreaded || !render_context)
+	{
+		return;
+	}
+
+	queue_context = nvgCreateQueue(1);
+	if (!queue_context)
+	{
+		printf("Could not init the render queue, rendering on the main thread.\n");
+		CORE->isThreaded = false;
+		return;
+	}
+	nvgqueueSetSync(queue_context, CP_Render_SyncCallback, NULL);
+	CORE->nvg = queue_context;
+}
+
+// Starts the render thread once the engine is initialized, the GL context moves to it
+void CP_Render_Start(void)
+{
+	if (!queue_context || render_running)
+	{
+		return;
+	}
+
+	// whatever was recorded during initialization is rendered here first
+	CP_Render_Submit();
+
+	if (mtx_init(&render_lock, mtx_plain) != thrd_success ||
+		cnd_init(&render_wake) != thrd_success ||
+		cnd_init(&render_done) != thrd_success)
+	{
+		printf("Could not start the render thread, rendering on the main thread.\n");
+		return;
+	}
+
+	glfwMakeContextCurrent(NULL);
+	render_quit = 0;
+	render_pending = 0;
+	if (thrd_create(&render_thread, CP_Render_ThreadMain, NULL) != thrd_success)
+	{
+		printf("Could not start the render thread, rendering on the main thread.\n");
+		glfwMakeContextCurrent(GetCPCore()->window);
+		return;
+	}
+	render_running = 1;
+}
+
+// Stops the render thread and renders anything still recorded, the GL context is back
+// on the main thread afterwards with no frames left in flight
+void CP_Render_Shutdown(void)
+{
+	if (render_running)
+	{
+		CP_Render_Wait();
+
+		mtx_lock(&render_lock);
+		render_quit = 1;
+		cnd_signal(&render_wake);
+		mtx_unlock(&render_lock);
+
+		thrd_join(render_thread, NULL);
+		render_running = 0;
+
+		cnd_destroy(&render_done);
+		cnd_destroy(&render_wake);
+		mtx_destroy(&render_lock);
+		glfwMakeContextCurrent(GetCPCore()->window);
+	}
+
+	if (queue_context)
+	{
+		CP_Render_Submit();
+	}
+
+	while (fence_count > 0)
+	{
+		CP_Render_WaitFence();
+	}
+
+	if (screen_framebuffer)
+	{
+		nvgluDeleteFramebuffer(screen_framebuffer);
+		screen_framebuffer = NULL;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+}
+
+void CP_Render_Call(NVGqueueCallback fn, const void* data, int size)
+{
+	if (queue_context)
+	{
+		nvgqueueCall(queue_context, fn, data, size);
+	}
+	else
+	{
+		fn((void*)data);
+	}
+}
+
+void CP_Render_Sync(void)
+{
+	if (queue_context)
+	{
+		CP_Render_Submit();
+		if (render_running)
+		{
+			CP_Render_Wait();
+		}
+	}
+}
+
+// Ends the frame on screen. With a render thread this waits for the previous frame
+// instead, so the game thread is never more than one frame ahead.
+void CP_Render_Present(void)
+{
+	CP_Render_Call(CP_Render_SwapBuffers, NULL, 0);
+	if (queue_context)
+	{
+		CP_Render_Submit();
+	}
+}
+
+// Sizes the screen framebuffer to the window's framebuffer, which clears it
+void CP_Render_SetScreenSize(int width, int height)
+{
+	int size[2] = { width, height };
+	CP_Render_Call(CP_Render_ResizeScreen, size, sizeof(size));
+}
+
+// Binds the screen for drawing and reading pixels, only call it where the GL context is current
+void CP_Render_BindScreen(void)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, screen_framebuffer ? screen_framebuffer->fbo : 0);
+}
+
+void CP_Render_SetVSync(CP_VSYNC_MODE mode)
+{
+	CP_Render_Call(CP_Render_ApplyVSync, &mode, sizeof(mode));
+}
+
+// One frame in flight waits for the GPU every frame, two lets the CPU work on the next
+// frame while the GPU draws (double buffering) and three allows one more (triple buffering)
+void CP_Render_SetFramesInFlight(unsigned frames)
+{
+	frames = frames < 1 ? 1 : frames > CP_MAX_FRAMES_IN_FLIGHT ? CP_MAX_FRAMES_IN_FLIGHT : frames;
+	CP_Render_Call(CP_Render_ApplyFramesInFlight, &frames, sizeof(frames));
+}
+
+int CP_Render_GetDrawCallCount(void)
+{
+	return frame_draw_calls;
+}
+
+NVGcontext* CP_Render_Context(void)
+{
+	return render_context;
+}
+
+int CP_Render_ImportImage(int image, int w, int h, int imageFlags)
+{
+	if (!queue_context || image == 0)
+	{
+		return image;
+	}
+	return nvgqueueImportImage(queue_context, image, w, h, imageFlags);
+}
@@ -80,6 +80,8 @@ CP_API void CP_Settings_StrokeWeight(float weight)
 
 CP_API void CP_Settings_Tint(CP_Color c)
 {
+	// batched sprites use the tint that is set when they are drawn
+	CP_Image_FlushBatch();
 	nvgTintColor(GetCPCore()->nvg, nvgRGBA(c.r, c.g, c.b, c.a));
 }
 
@@ -137,6 +139,8 @@ CP_API void CP_Settings_BlendMode(CP_BLEND_MODE blendMode)
 	if (!CORE || !CORE->nvg)
 		return; // break?
 
+	CP_Image_FlushBatch();
+
 	switch (blendMode)
 	{
 	case CP_BLEND_MAX:
@@ -248,6 +252,8 @@ CP_API void CP_Settings_Restore(void)
 	if (!CORE || !CORE->nvg)
 		return; // break?
 
+	// the restored state can have a different tint or blend mode
+	CP_Image_FlushBatch();
 	nvgRestore(CORE->nvg);
 
 	// also restore the DrawInfo details
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// file:	CP_Shape.c
+// author:	Justin Chambers
+// brief:	Shapes recorded once and redrawn without tessellating them again
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <math.h>
+#include <stdlib.h>
+#include "cprocessing.h"
+#include "Internal_Shape.h"
+#include "Internal_System.h"
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+#define CP_INITIAL_SHAPE_VERTICES 16
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+// Fill and stroke follow CP_Graphics_EndShape, a filled shape has a closed outline
+static void CP_Shape_DrawInternal(CP_Shape shape)
+{
+	CP_CorePtr CORE = GetCPCore();
+	CP_DrawInfoPtr DI = GetDrawInfo();
+
+	if (!CORE || !CORE->nvg || !DI || shape->count < 2)
+		return;
+
+	// a filled shape is stroked closed, only an outline has caps
+	if (CP_Cull_Rect(shape->bounds[0], shape->bounds[1], shape->bounds[2], shape->bounds[3], CP_Graphics_StrokeReach(!DI->fill)))
+		return;
+
+	// the geometry is built the first time the shape is drawn after it changed
+	if (!shape->geometry)
+	{
+		shape->geometry = nvgCreateShape(CORE->nvg, shape->points, shape->count);
+		if (!shape->geometry)
+			return;
+	}
+
+	if (DI->fill)
+	{
+		nvgFillShape(CORE->nvg, shape->geometry);
+	}
+	if (DI->stroke)
+	{
+		nvgStrokeShape(CORE->nvg, shape->geometry, DI->fill);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Library Functions:
+//------------------------------------------------------------------------------
+
+CP_API CP_Shape CP_Shape_Create(void)
+{
+	CP_Shape shape = (CP_Shape)calloc(1, sizeof(CP_Shape_Struct));
+	return shape;
+}
+
+CP_API void CP_Shape_AddVertex(CP_Shape shape, float x, float y)
+{
+	if (!shape)
+	{
+		return;
+	}
+
+	if (shape->count == shape->capacity)
+	{
+		int capacity = shape->capacity ? shape->capacity * 2 : CP_INITIAL_SHAPE_VERTICES;
+		float* points = (float*)realloc(shape->points, capacity * 2 * sizeof(float));
+		if (!points)
+		{
+			return;
+		}
+		shape->points = points;
+		shape->capacity = capacity;
+	}
+
+	shape->points[shape->count * 2] = x;
+	shape->points[shape->count * 2 + 1] = y;
+	if (shape->count == 0)
+	{
+		shape->bounds[0] = shape->bounds[2] = x;
+		shape->bounds[1] = shape->bounds[3] = y;
+	}
+	else
+	{
+		shape->bounds[0] = fminf(shape->bounds[0], x);
+		shape->bounds[1] = fminf(shape->bounds[1], y);
+		shape->bounds[2] = fmaxf(shape->bounds[2], x);
+		shape->bounds[3] = fmaxf(shape->bounds[3], y);
+	}
+	shape->count++;
+
+	// the cached geometry no longer matches
+	CP_CorePtr CORE = GetCPCore();
+	if (shape->geometry && CORE && CORE->nvg)
+	{
+		nvgDeleteShape(CORE->nvg, shape->geometry);
+		shape->geometry = NULL;
+	}
+}
+
+CP_API void CP_Shape_Draw(CP_Shape shape)
+{
+	if (!shape)
+	{
+		return;
+	}
+
+	CP_Shape_DrawInternal(shape);
+}
+
+CP_API void CP_Shape_DrawAdvanced(CP_Shape shape, float x, float y, float degrees)
+{
+	CP_CorePtr CORE = GetCPCore();
+	if (!shape || !CORE || !CORE->nvg)
+	{
+		return;
+	}
+
+	nvgSave(CORE->nvg);
+	nvgTranslate(CORE->nvg, x, y);
+	nvgRotate(CORE->nvg, CP_Math_Radians(degrees));
+
+	CP_Shape_DrawInternal(shape);
+
+	nvgRestore(CORE->nvg);
+}
+
+CP_API void CP_Shape_Free(CP_Shape* shape)
+{
+	if (shape == NULL || *shape == NULL)
+	{
+		return;
+	}
+
+	CP_CorePtr CORE = GetCPCore();
+	if (!CORE || !CORE->nvg) return;
+
+	nvgDeleteShape(CORE->nvg, (*shape)->geometry);
+	free((*shape)->points);
+	free(*shape);
+	*shape = NULL;
+}
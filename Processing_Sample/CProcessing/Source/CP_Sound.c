@@ -10,28 +10,24 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
+#include <stdlib.h>
 #include "cprocessing.h"
 #include "Internal_Sound.h"
-#include "vect.h"
+#include "Internal_System.h"
 
 //------------------------------------------------------------------------------
 // Defines and Internal Variables:
 //------------------------------------------------------------------------------
 
 #define MAX_FMOD_CHANNELS 128
-#define CP_INITIAL_SOUND_CAPACITY   12
 #define FMOD_TRUE 1
 #define FMOD_FALSE 0
 
 #define CP_SOUND_DSP_PARAM_NOTUSED -1
 
-VECT_GENERATE_TYPE(CP_Sound)
-
 static FMOD_RESULT result = 0;
 static FMOD_SYSTEM* _fmod_system = NULL;
 
-static vect_CP_Sound* sound_vector = NULL;
-
 static FMOD_CHANNELGROUP* channel_groups[CP_SOUND_GROUP_MAX] = { NULL };
 //static FMOD_DSP* dsp_list[CP_SOUND_DSP_MAX] = { NULL };
 
@@ -46,25 +42,8 @@ static BOOL CP_IsValidSoundGroup(CP_SOUND_GROUP group)
 	return group >= 0 && group < CP_SOUND_GROUP_MAX;
 }
 
-static CP_Sound CP_CheckIfSoundIsLoaded(const char* filepath)
-{
-	for (unsigned i = 0; i < sound_vector->size; ++i)
-	{
-		CP_Sound snd = vect_at_CP_Sound(sound_vector, i);
-		if (snd && !strcmp(filepath, snd->filepath))
-		{
-			return snd;
-		}
-	}
-
-	return NULL;
-}
-
 void CP_Sound_Init(void)
 {
-	// Allocate the initial vector size for loaded sounds
-	sound_vector = vect_init_CP_Sound(CP_INITIAL_SOUND_CAPACITY);
-
 	// Create the FMOD system
 	result = FMOD_System_Create(&_fmod_system);
 	if (result != FMOD_OK)
@@ -75,6 +54,12 @@ void CP_Sound_Init(void)
 		return;
 	}
 
+	// Headless runs (build and benchmark machines) may have no audio device
+	if (GetCPCore()->isHeadless)
+	{
+		FMOD_System_SetOutput(_fmod_system, FMOD_OUTPUTTYPE_NOSOUND);
+	}
+
 	// Initialize the system
 	result = FMOD_System_Init(_fmod_system, MAX_FMOD_CHANNELS, FMOD_INIT_NORMAL, NULL);
 	if (result != FMOD_OK)
@@ -203,18 +188,16 @@ void CP_Sound_Shutdown(void)
 		CP_Sound_StopAll();
 
 		// Free sounds 
-		for (unsigned i = 0; i < sound_vector->size; ++i)
+		int cursor = 0;
+		CP_Sound sound = NULL;
+		while ((sound = (CP_Sound)CP_Asset_Next(CP_ASSET_SOUND, &cursor)) != NULL)
 		{
-			CP_Sound sound = vect_at_CP_Sound(sound_vector, i);
 			// Release the sound from FMOD
 			FMOD_Sound_Release(sound->sound);
 			// Free the struct's memory
 			free(sound);
 		}
 
-		// Free lists
-		vect_free(sound_vector);
-
 		// Release system
 		FMOD_System_Release(_fmod_system);
 		_fmod_system = NULL;
@@ -228,8 +211,8 @@ CP_Sound CP_Sound_LoadInternal(const char* filepath, CP_BOOL streamFromDisc)
 
 	CP_Sound sound = NULL;
 
-	// Check if the sound is already loaded
-	sound = CP_CheckIfSoundIsLoaded(filepath);
+	// Check if the sound is already loaded, that takes another reference to it
+	sound = (CP_Sound)CP_Asset_Acquire(CP_ASSET_SOUND, filepath);
 	if (sound)
 	{
 		return sound;
@@ -243,15 +226,32 @@ CP_Sound CP_Sound_LoadInternal(const char* filepath, CP_BOOL streamFromDisc)
 		return NULL;
 	}
 
+	// Sounds in an open pack are read straight from its mapped memory, which stays valid until shutdown
+	const char* source = filepath;
+	FMOD_MODE mode = FMOD_DEFAULT;
+	FMOD_CREATESOUNDEXINFO* info = NULL;
+	FMOD_CREATESOUNDEXINFO packInfo;
+	const unsigned char* data = NULL;
+	unsigned size = 0;
+	if (CP_Pack_Find(filepath, &data, &size))
+	{
+		memset(&packInfo, 0, sizeof(FMOD_CREATESOUNDEXINFO));
+		packInfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+		packInfo.length = size;
+		source = (const char*)data;
+		mode |= FMOD_OPENMEMORY_POINT;
+		info = &packInfo;
+	}
+
 	// Create the FMOD sound
 	if (streamFromDisc)
 	{
-		result = FMOD_System_CreateStream(_fmod_system, filepath, FMOD_DEFAULT, NULL, &(sound->sound));
+		result = FMOD_System_CreateStream(_fmod_system, source, mode, info, &(sound->sound));
 
 	}
 	else
 	{
-		result = FMOD_System_CreateSound(_fmod_system, filepath, FMOD_DEFAULT, NULL, &(sound->sound));
+		result = FMOD_System_CreateSound(_fmod_system, source, mode, info, &(sound->sound));
 	}
 	if (result != FMOD_OK)
 	{
@@ -260,11 +260,15 @@ CP_Sound CP_Sound_LoadInternal(const char* filepath, CP_BOOL streamFromDisc)
 		return NULL;
 	}
 
-	// Set filepath string for cache checking
-	strcpy_s(sound->filepath, MAX_PATH, filepath);
-
-	// Add it to the list
-	vect_push_CP_Sound(sound_vector, sound);
+	// Register it so the path is found the next time it is loaded
+	sound->asset = CP_Asset_Add(CP_ASSET_SOUND, filepath, sound);
+	if (sound->asset == CP_ASSET_NONE)
+	{
+		FMOD_Sound_Release(sound->sound);
+		free(sound);
+		return NULL;
+	}
+	sound->filepath = CP_Asset_GetPath(sound->asset);
 
 	return sound;
 }
@@ -318,24 +322,15 @@ CP_API void CP_Sound_Free(CP_Sound* sound)
 		return;
 	}
 
-	// Find the sound in the list
-	for (unsigned i = 0; i < sound_vector->size; ++i)
+	// A sound loaded more than once stays loaded until every load has been freed
+	if (CP_Asset_Release((*sound)->asset) == 0)
 	{
-		// Check if this pointer is the same as the one we're looking for
-		if (vect_at_CP_Sound(sound_vector, i) == *sound)
-		{
-			// Remove the sound from the list
-			vect_rem_CP_Sound(sound_vector, i);
-			// Release the sound from FMOD
-			FMOD_Sound_Release((*sound)->sound);
-			// Free the struct's memory
-			free(*sound);
-			*sound = NULL;
-			return;
-		}
+		// Release the sound from FMOD
+		FMOD_Sound_Release((*sound)->sound);
+		// Free the struct's memory
+		free(*sound);
 	}
-
-	// TODO: handle error - we reached the end of the list without finding the sound
+	*sound = NULL;
 }
 
 /*
@@ -10,10 +10,10 @@
 // Include Files:
 //------------------------------------------------------------------------------
 
+#include <stdlib.h>
 #include "cprocessing.h"
 #include "Internal_Text.h"
 #include "Internal_System.h"
-#include "vect.h"
 #include "Internal_Resources.h"
 
 //------------------------------------------------------------------------------
@@ -21,44 +21,25 @@
 //------------------------------------------------------------------------------
 
 #define FONT_LOAD_ERROR -1
-#define CP_INITIAL_FONT_COUNT 16
-
-VECT_GENERATE_TYPE(CP_Font)
 
 static CP_Font  _default_font = NULL;
 
-static vect_CP_Font* font_vector;
-
 //------------------------------------------------------------------------------
 // Internal Functions:
 //------------------------------------------------------------------------------
 
-static CP_Font CP_Font_IsLoaded(const char* filepath)
-{
-	for (unsigned i = 0; i < font_vector->size; ++i)
-	{
-		CP_Font font = vect_at_CP_Font(font_vector, i);
-		if (font && !strcmp(filepath, font->filepath))
-		{
-			return font;
-		}
-	}
-
-	return NULL;
-}
-
-static void CP_Font_AddHandle(CP_Font font)
-{
-	vect_push_CP_Font(font_vector, font);
-}
-
 static CP_Font CP_Font_LoadInternal(const char* filepath, bool fromMemory, unsigned char* data, int ndata, int freeData)
 {
 	CP_Font new_font = NULL;
 	CP_CorePtr CORE = GetCPCore();
 
+	if (!filepath)
+	{
+		return NULL;
+	}
+
 	// Check if the font is already loaded
-	new_font = CP_Font_IsLoaded(filepath);
+	new_font = (CP_Font)CP_Asset_Acquire(CP_ASSET_FONT, filepath);
 	if (new_font)
 	{
 		return new_font;
@@ -73,7 +54,8 @@ static CP_Font CP_Font_LoadInternal(const char* filepath, bool fromMemory, unsig
 
 	new_font->load_error = FALSE;
 	new_font->handle = -1;
-	strcpy_s(new_font->filepath, MAX_PATH, filepath);
+	new_font->filepath = NULL;
+	new_font->asset = CP_ASSET_NONE;
 
 	if (!CORE || !CORE->nvg)
 	{
@@ -82,6 +64,27 @@ static CP_Font CP_Font_LoadInternal(const char* filepath, bool fromMemory, unsig
 		return NULL;
 	}
 
+	// Register the font so the path is found the next time it is loaded. NanoVG can not delete
+	// a font, so this is done before creating it to never leave one behind that nothing owns.
+	new_font->asset = CP_Asset_Add(CP_ASSET_FONT, filepath, new_font);
+	if (new_font->asset == CP_ASSET_NONE)
+	{
+		free(new_font);
+		return NULL;
+	}
+	new_font->filepath = CP_Asset_GetPath(new_font->asset);
+
+	// fonts in an open pack are used from its mapped memory, which stays valid until shutdown
+	const unsigned char* packData = NULL;
+	unsigned packSize = 0;
+	if (!fromMemory && CP_Pack_Find(filepath, &packData, &packSize))
+	{
+		fromMemory = true;
+		data = (unsigned char*)packData;
+		ndata = (int)packSize;
+		freeData = 0;
+	}
+
 	if (fromMemory)
 	{
 		new_font->handle = nvgCreateFontMem(CORE->nvg, filepath, data, ndata, freeData);
@@ -94,23 +97,18 @@ static CP_Font CP_Font_LoadInternal(const char* filepath, bool fromMemory, unsig
 	if (new_font->handle == FONT_LOAD_ERROR)
 	{
 		new_font->load_error = TRUE;
+		CP_Asset_Release(new_font->asset);
 		free(new_font);
 		return NULL;
 	}
 
 	new_font->load_error = FALSE;
 
-	// Store a pointer to the font
-	CP_Font_AddHandle(new_font);
-
 	return new_font;
 }
 
 void CP_Text_Init(void)
 {
-	// initialize our vector
-	font_vector = vect_init_CP_Font(CP_INITIAL_FONT_COUNT);
-
 	// load the default font from internal binary resource data
 	_default_font = CP_Font_LoadInternal("./Assets/Exo2-Regular.ttf", true, Exo2_Regular_ttf, Exo2_Regular_ttf_size, 0);
 }
@@ -123,16 +121,12 @@ void CP_Text_Shutdown(void)
 		return;
 	}
 
-	for (unsigned i = 0; i < font_vector->size; ++i)
+	int cursor = 0;
+	CP_Font font = NULL;
+	while ((font = (CP_Font)CP_Asset_Next(CP_ASSET_FONT, &cursor)) != NULL)
 	{
-		CP_Font font = vect_at_CP_Font(font_vector, i);
-		if (font)
-		{
-			free(font);
-		}
+		free(font);
 	}
-
-	vect_free_CP_Font(font_vector);
 }
 
 //------------------------------------------------------------------------------
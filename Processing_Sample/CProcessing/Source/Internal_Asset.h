@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Asset.h
+// author:	Justin Chambers
+// brief:	Registry of loaded images, sounds and fonts shared by their modules
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+#define CP_ASSET_NONE -1
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+typedef enum CP_ASSET_TYPE
+{
+	CP_ASSET_IMAGE,
+	CP_ASSET_SOUND,
+	CP_ASSET_FONT,
+	CP_ASSET_TYPE_MAX
+} CP_ASSET_TYPE;
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// INTERNAL USE
+void CP_Asset_Shutdown(void);
+
+// Finds a loaded asset by its path and takes a reference to it, NULL if it is not loaded
+void* CP_Asset_Acquire(CP_ASSET_TYPE type, const char* path);
+
+// Registers a newly loaded asset holding one reference. The path can be NULL for assets that
+// were not loaded from a file, those are never found by CP_Asset_Acquire. Returns the asset's id
+// or CP_ASSET_NONE if it could not be registered.
+int CP_Asset_Add(CP_ASSET_TYPE type, const char* path, void* data);
+
+// Drops a reference and returns how many are left. At zero the asset is unregistered and the
+// caller frees it.
+int CP_Asset_Release(int id);
+
+// The interned copy of the asset's path, stays valid until shutdown. NULL without a path.
+const char* CP_Asset_GetPath(int id);
+
+// Walks the registered assets of a type, start with a cursor of 0. NULL once there are no more.
+void* CP_Asset_Next(CP_ASSET_TYPE type, int* cursor);
+
+#ifdef __cplusplus
+}
+#endif
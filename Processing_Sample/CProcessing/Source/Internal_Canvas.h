@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Canvas.h
+// author:	Justin Chambers
+// brief:	Offscreen canvases that are drawn into and then drawn as images
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+typedef struct CP_Canvas_Struct
+{
+    struct NVGLUframebuffer* framebuffer; // GL framebuffer object, NULL when running headless
+    CP_Image_Struct image;                // the canvas contents, drawn like any other image
+    int dirty;                            // the contents need to be drawn again
+} CP_Canvas_Struct;
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+}
+#endif
@@ -33,10 +33,21 @@ extern "C" {
 typedef struct CP_Image_Struct
 {
     int handle;              // handle to the nanoVG image
-    char filepath[MAX_PATH]; // full path of the image
+    const char* filepath;    // interned path of the image, NULL when not loaded from a file
+    int asset;               // id in the asset registry
     int w;                   // width of the image
     int h;                   // height of the image
     int load_error;          // was there an error loading the image
+    int flip_y;              // rows are stored bottom to top, as canvases are on GL
+    int status;              // CP_IMAGE_STATUS
+    struct CP_ImageLoad* load;  // pending CP_Image_LoadAsync, NULL once it has finished
+    struct CP_Image_Struct* atlas;  // texture a sub image of an atlas draws from, NULL otherwise
+    int atlas_x;             // position of a sub image in its atlas
+    int atlas_y;
+    unsigned last_used;      // frame the image was last drawn on
+    int evicted;             // texture was given up for the texture budget, reloaded from filepath when drawn
+    struct CP_Image_Struct* lru_prev;  // images that can be evicted, least recently drawn first
+    struct CP_Image_Struct* lru_next;
 } CP_Image_Struct;
 
 //------------------------------------------------------------------------------
@@ -53,6 +64,10 @@ typedef struct CP_Image_Struct
 
 // INTERNAL USE
 void CP_ImageShutdown(void);
+void CP_Image_FlushBatch(void);
+void CP_Image_LoadFrameStart(void);
+void CP_Image_CaptureFrameEnd(void);
+void CP_Image_BudgetFrameEnd(void);
 
 #ifdef __cplusplus
 }
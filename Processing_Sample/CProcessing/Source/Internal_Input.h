@@ -33,6 +33,7 @@ void CP_Input_MouseCallback(GLFWwindow* window, int button, int action, int mods
 void CP_Input_MouseWheelCallback(GLFWwindow* window, double xoffset, double yoffset);
 void CP_Input_Init(void);
 void CP_Input_Update(void);
+void CP_Input_Shutdown(void);
 void CP_Input_KeyboardUpdate(void);
 void CP_Input_MouseUpdate(void);
 void CP_Input_GamepadUpdate(void);
@@ -44,6 +44,11 @@ extern "C" {
 
 void mat3_convert_nvg_to_std(CP_Matrix * mat);
 
+void CP_Cull_FrameStart(float width, float height);
+void CP_Cull_SetViewport(float width, float height);
+CP_BOOL CP_Cull_Rect(float x0, float y0, float x1, float y1, float margin);
+unsigned CP_Cull_GetLastFrameCount(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Pack.h
+// author:	Justin Chambers
+// brief:	Memory mapped .cpak asset packs
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+// A pack is a header, the table of contents, the NUL terminated paths the table points into and
+// then the files, each starting on a CP_PACK_ALIGN boundary. Tools/cpak.c writes them.
+#define CP_PACK_MAGIC		0x4B415043u		// "CPAK"
+#define CP_PACK_VERSION		1
+#define CP_PACK_ALIGN		16
+#define CP_PACK_MAX_PATH	260
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+typedef struct CP_PackHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t count;			// entries in the table of contents
+	uint32_t names_size;	// bytes of paths after the table
+} CP_PackHeader;
+
+// The table is sorted by hash and then by path, paths are normalized with CP_Pack_NormalizePath
+typedef struct CP_PackEntry
+{
+	uint32_t hash;			// FNV-1a of the normalized path
+	uint32_t name;			// offset of the path from the start of the paths
+	uint64_t offset;		// offset of the file from the start of the pack
+	uint64_t size;
+} CP_PackEntry;
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// INTERNAL USE
+void CP_Pack_Shutdown(void);
+
+// Lower case with forward slashes and without a leading "./", the form paths are stored in.
+// Returns the hash of the result, out holds at least CP_PACK_MAX_PATH characters.
+// Shared with Tools/cpak.c so packs are written with the paths they are looked up by.
+static inline uint32_t CP_Pack_NormalizePath(const char* filepath, char* out)
+{
+	while (filepath[0] == '.' && (filepath[1] == '/' || filepath[1] == '\\'))
+	{
+		filepath += 2;
+	}
+
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	int length = 0;
+	for (; *filepath && length < CP_PACK_MAX_PATH - 1; ++filepath)
+	{
+		char c = *filepath;
+		if (c == '\\')
+			c = '/';
+		else if (c >= 'A' && c <= 'Z')
+			c += 'a' - 'A';
+		out[length++] = c;
+		hash ^= (unsigned char)c;
+		hash *= 16777619u;
+	}
+	out[length] = '\0';
+	return hash;
+}
+
+// Looks the file up in the open packs, the last one opened first. The data stays mapped until
+// shutdown. Returns FALSE when no pack holds it and it should be loaded from disk instead.
+int CP_Pack_Find(const char* filepath, const unsigned char** data, unsigned* size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Profile.h
+// author:	Justin Chambers
+// brief:	Engine hooks for the profiler
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// INTERNAL USE
+void CP_Profile_FrameStart(void);
+void CP_Profile_FrameEnd(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,6 +16,8 @@ extern "C" {
 
 // Internal use
 void CP_Random_Init(void);
+void CP_Random_GetState(unsigned int state[4]);
+void CP_Random_SetState(const unsigned int state[4]);
 
 #ifdef __cplusplus
 }
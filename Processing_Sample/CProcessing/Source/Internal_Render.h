@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Render.h
+// author:	Justin Chambers
+// brief:	Render thread that replays the game thread's drawing on the GL context
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#include "nanovg_queue.h"
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// INTERNAL USE
+void CP_Render_Init(void);
+void CP_Render_Start(void);
+void CP_Render_Shutdown(void);
+
+// Runs fn with a copy of data where the GL context is current, in order with the drawing.
+// Without a render thread this is right away.
+void CP_Render_Call(NVGqueueCallback fn, const void* data, int size);
+
+// Waits until everything recorded so far has been rendered
+void CP_Render_Sync(void);
+
+// Hands the frame to the render thread and has it present the screen when done
+void CP_Render_Present(void);
+
+// The screen is an offscreen framebuffer that keeps its contents between frames, it is
+// copied to the window when presented. Resizing it clears it.
+void CP_Render_SetScreenSize(int width, int height);
+void CP_Render_BindScreen(void);
+
+// Presentation settings, applied in order with the drawing
+void CP_Render_SetVSync(CP_VSYNC_MODE mode);
+void CP_Render_SetFramesInFlight(unsigned frames);
+
+// GL draw calls of the last frame that was presented, after calls were merged
+int CP_Render_GetDrawCallCount(void);
+
+// The context that renders to GL, only use it inside CP_Render_Call
+NVGcontext* CP_Render_Context(void);
+
+// Makes an image created on the render context drawable with GetCPCore()->nvg
+int CP_Render_ImportImage(int image, int w, int h, int imageFlags);
+
+#ifdef __cplusplus
+}
+#endif
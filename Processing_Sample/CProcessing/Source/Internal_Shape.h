@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+// file:	Internal_Shape.h
+// author:	Justin Chambers
+// brief:	Shapes recorded once and redrawn from cached geometry
+//
+// INTERNAL USE ONLY, DO NOT DISTRIBUTE
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Defines:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Consts:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Structures:
+//------------------------------------------------------------------------------
+
+typedef struct CP_Shape_Struct
+{
+    float* points;               // x,y pairs of the recorded vertices
+    int count;                   // number of vertices
+    int capacity;                // number of vertices the points array can hold
+    float bounds[4];             // min x, min y, max x, max y of the recorded vertices
+    struct NVGshape* geometry;   // cached fill and stroke geometry, NULL until the shape is drawn
+} CP_Shape_Struct;
+
+//------------------------------------------------------------------------------
+// Public Enums:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Variables:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Public Functions:
+//------------------------------------------------------------------------------
+
+// How far the current stroke reaches past a shape's points, 0 without stroke (CP_Graphics.c)
+float CP_Graphics_StrokeReach(CP_BOOL open);
+
+#ifdef __cplusplus
+}
+#endif
@@ -34,7 +34,8 @@ extern "C" {
 
 typedef struct CP_Sound_Struct
 {
-	char filepath[MAX_PATH];
+	const char* filepath;	// interned path of the sound
+	int asset;				// id in the asset registry
     FMOD_SOUND* sound;
 } CP_Sound_Struct;
 
@@ -21,14 +21,22 @@ extern "C" {
 // NanoVG
 #define NANOVG_GL3_IMPLEMENTATION
 #include "nanovg.h"
+#include "nanovg_sw.h"
 
+#include "Internal_Asset.h"
 #include "Internal_Color.h"
 #include "Internal_File.h"
 #include "Internal_Image.h"
+#include "Internal_Canvas.h"
 #include "Internal_Input.h"
+#include "Internal_Job.h"
 #include "Internal_Math.h"
 #include "Internal_Random.h"
+#include "Internal_Render.h"
+#include "Internal_Shape.h"
 #include "Internal_Noise.h"
+#include "Internal_Pack.h"
+#include "Internal_Profile.h"
 #include "Internal_Sound.h"
 #include "Internal_Text.h"
 
@@ -65,6 +73,8 @@ typedef struct CP_Core
 	int native_width;
 	int native_height;
 	bool isFullscreen;
+	bool isHeadless;		// rendering to the software framebuffer, no window or GL context
+	bool isThreaded;		// nvg records the drawing for a render thread that owns the GL context
     float pixel_ratio;
     int window_posX;
     int window_posY;
@@ -88,7 +98,10 @@ void CP_FrameEnd(void);
 void CP_FrameRate_Init(void);
 void CP_FrameRate_FrameStart(void);
 void CP_FrameRate_FrameEnd(void);
+void CP_FrameRate_Shutdown(void);
 void CP_UpdateFrameTime(void);
+double CP_GetTimeInternal(void);
+void CP_SetFrameTimeInternal(double frametime);
 void CP_IncFrameCount(void);
 
 #ifdef __cplusplus
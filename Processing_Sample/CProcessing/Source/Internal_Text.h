@@ -33,7 +33,8 @@ extern "C" {
 typedef struct CP_Font_Struct
 {
     int handle;
-    char filepath[MAX_PATH];
+    const char* filepath;   // interned path of the font
+    int asset;              // id in the asset registry
     int load_error;
 } CP_Font_Struct;
 
@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------------
+// file:	cpak.c
+// author:	Justin Chambers
+// brief:	Offline packer for the .cpak asset packs opened with CP_Pack_Open
+//
+//	usage:	cpak <output.cpak> <file or directory>...
+//	build:	cl /O2 cpak.c		or		cc -O2 -o cpak cpak.c
+//
+//	Directories are packed recursively. Files are stored under the path they were found at,
+//	so "cpak Assets.cpak ./Assets" serves CP_Image_Load("./Assets/image.png") from the pack.
+//
+// Copyright  2026 DigiPen, All rights reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Include Files:
+//------------------------------------------------------------------------------
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Source/Internal_Pack.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+//------------------------------------------------------------------------------
+// Defines and Internal Variables:
+//------------------------------------------------------------------------------
+
+typedef struct PackFile
+{
+	char* path;						// as found on disk
+	char name[CP_PACK_MAX_PATH];	// as stored in the pack
+	uint32_t hash;
+	uint64_t size;
+	uint64_t offset;
+} PackFile;
+
+static PackFile* files = NULL;
+static int file_count = 0;
+static int file_max = 0;
+static char output_name[CP_PACK_MAX_PATH];	// never packed into itself
+
+//------------------------------------------------------------------------------
+// Internal Functions:
+//------------------------------------------------------------------------------
+
+static int AddFile(const char* path)
+{
+	if (strlen(path) >= CP_PACK_MAX_PATH)
+	{
+		fprintf(stderr, "cpak: skipping %s, the path is too long\n", path);
+		return 1;
+	}
+
+	char name[CP_PACK_MAX_PATH];
+	uint32_t hash = CP_Pack_NormalizePath(path, name);
+	if (!strcmp(name, output_name))
+	{
+		return 1;
+	}
+
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		fprintf(stderr, "cpak: cannot open %s\n", path);
+		return 0;
+	}
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fclose(file);
+	if (size < 0)
+	{
+		fprintf(stderr, "cpak: cannot read %s\n", path);
+		return 0;
+	}
+
+	if (file_count == file_max)
+	{
+		int capacity = file_max ? file_max * 2 : 64;
+		PackFile* temp = (PackFile*)realloc(files, capacity * sizeof(PackFile));
+		if (!temp)
+		{
+			fprintf(stderr, "cpak: out of memory\n");
+			return 0;
+		}
+		files = temp;
+		file_max = capacity;
+	}
+
+	PackFile* entry = &files[file_count++];
+	memset(entry, 0, sizeof(PackFile));
+	entry->path = (char*)malloc(strlen(path) + 1);
+	if (!entry->path)
+	{
+		fprintf(stderr, "cpak: out of memory\n");
+		return 0;
+	}
+	strcpy(entry->path, path);
+	strcpy(entry->name, name);
+	entry->hash = hash;
+	entry->size = (uint64_t)size;
+	return 1;
+}
+
+// Adds a file, or every file under a directory
+static int AddPath(const char* path)
+{
+#ifdef _WIN32
+	DWORD attributes = GetFileAttributesA(path);
+	if (attributes == INVALID_FILE_ATTRIBUTES)
+	{
+		fprintf(stderr, "cpak: cannot find %s\n", path);
+		return 0;
+	}
+	if (!(attributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		return AddFile(path);
+	}
+
+	char pattern[MAX_PATH];
+	snprintf(pattern, sizeof(pattern), "%s/*", path);
+	WIN32_FIND_DATAA found;
+	HANDLE find = FindFirstFileA(pattern, &found);
+	if (find == INVALID_HANDLE_VALUE)
+	{
+		return 1;
+	}
+	int ok = 1;
+	do
+	{
+		if (!strcmp(found.cFileName, ".") || !strcmp(found.cFileName, ".."))
+			continue;
+		char child[MAX_PATH];
+		snprintf(child, sizeof(child), "%s/%s", path, found.cFileName);
+		ok = AddPath(child);
+	} while (ok && FindNextFileA(find, &found));
+	FindClose(find);
+	return ok;
+#else
+	struct stat info;
+	if (stat(path, &info))
+	{
+		fprintf(stderr, "cpak: cannot find %s\n", path);
+		return 0;
+	}
+	if (!S_ISDIR(info.st_mode))
+	{
+		return AddFile(path);
+	}
+
+	DIR* dir = opendir(path);
+	if (!dir)
+	{
+		return 1;
+	}
+	int ok = 1;
+	struct dirent* found;
+	while (ok && (found = readdir(dir)) != NULL)
+	{
+		if (!strcmp(found->d_name, ".") || !strcmp(found->d_name, ".."))
+			continue;
+		char child[4096];
+		snprintf(child, sizeof(child), "%s/%s", path, found->d_name);
+		ok = AddPath(child);
+	}
+	closedir(dir);
+	return ok;
+#endif
+}
+
+// The order the runtime binary searches in
+static int CompareFiles(const void* a, const void* b)
+{
+	const PackFile* fa = (const PackFile*)a;
+	const PackFile* fb = (const PackFile*)b;
+	if (fa->hash != fb->hash)
+	{
+		return fa->hash < fb->hash ? -1 : 1;
+	}
+	return strcmp(fa->name, fb->name);
+}
+
+static int WritePadding(FILE* out, uint64_t* position)
+{
+	static const char zeros[CP_PACK_ALIGN] = { 0 };
+	size_t padding = (size_t)((CP_PACK_ALIGN - *position % CP_PACK_ALIGN) % CP_PACK_ALIGN);
+	*position += padding;
+	return fwrite(zeros, 1, padding, out) == padding;
+}
+
+static int CopyIntoPack(FILE* out, const PackFile* entry)
+{
+	FILE* in = fopen(entry->path, "rb");
+	if (!in)
+	{
+		fprintf(stderr, "cpak: cannot open %s\n", entry->path);
+		return 0;
+	}
+
+	char buffer[65536];
+	uint64_t copied = 0;
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), in)) > 0)
+	{
+		if (fwrite(buffer, 1, read, out) != read)
+		{
+			fclose(in);
+			return 0;
+		}
+		copied += read;
+	}
+	fclose(in);
+
+	if (copied != entry->size)
+	{
+		fprintf(stderr, "cpak: %s changed while packing\n", entry->path);
+		return 0;
+	}
+	return 1;
+}
+
+static int WritePack(const char* filepath)
+{
+	qsort(files, file_count, sizeof(PackFile), CompareFiles);
+
+	// a path given twice, or twice under different spellings, is packed once
+	int count = 0;
+	for (int i = 0; i < file_count; ++i)
+	{
+		if (count > 0 && !CompareFiles(&files[count - 1], &files[i]))
+		{
+			fprintf(stderr, "cpak: skipping %s, it is already packed\n", files[i].path);
+			free(files[i].path);
+			continue;
+		}
+		files[count++] = files[i];
+	}
+	file_count = count;
+
+	// lay out the table, the paths and then the files
+	uint32_t namesSize = 0;
+	for (int i = 0; i < file_count; ++i)
+	{
+		namesSize += (uint32_t)strlen(files[i].name) + 1;
+	}
+	uint64_t position = sizeof(CP_PackHeader) + (uint64_t)file_count * sizeof(CP_PackEntry) + namesSize;
+	for (int i = 0; i < file_count; ++i)
+	{
+		position += (CP_PACK_ALIGN - position % CP_PACK_ALIGN) % CP_PACK_ALIGN;
+		files[i].offset = position;
+		position += files[i].size;
+	}
+
+	FILE* out = fopen(filepath, "wb");
+	if (!out)
+	{
+		fprintf(stderr, "cpak: cannot create %s\n", filepath);
+		return 0;
+	}
+
+	CP_PackHeader header;
+	header.magic = CP_PACK_MAGIC;
+	header.version = CP_PACK_VERSION;
+	header.count = (uint32_t)file_count;
+	header.names_size = namesSize;
+	int ok = fwrite(&header, sizeof(header), 1, out) == 1;
+
+	uint32_t name = 0;
+	for (int i = 0; i < file_count && ok; ++i)
+	{
+		CP_PackEntry entry;
+		entry.hash = files[i].hash;
+		entry.name = name;
+		entry.offset = files[i].offset;
+		entry.size = files[i].size;
+		ok = fwrite(&entry, sizeof(entry), 1, out) == 1;
+		name += (uint32_t)strlen(files[i].name) + 1;
+	}
+	for (int i = 0; i < file_count && ok; ++i)
+	{
+		ok = fwrite(files[i].name, strlen(files[i].name) + 1, 1, out) == 1;
+	}
+
+	position = sizeof(CP_PackHeader) + (uint64_t)file_count * sizeof(CP_PackEntry) + namesSize;
+	for (int i = 0; i < file_count && ok; ++i)
+	{
+		ok = WritePadding(out, &position) && CopyIntoPack(out, &files[i]);
+		position += files[i].size;
+	}
+
+	if (fclose(out) != 0 || !ok)
+	{
+		fprintf(stderr, "cpak: failed writing %s\n", filepath);
+		remove(filepath);
+		return 0;
+	}
+
+	printf("cpak: packed %d files into %s (%llu bytes)\n", file_count, filepath, (unsigned long long)position);
+	return 1;
+}
+
+//------------------------------------------------------------------------------
+// Main:
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		fprintf(stderr, "usage: cpak <output.cpak> <file or directory>...\n");
+		return 1;
+	}
+
+	CP_Pack_NormalizePath(argv[1], output_name);
+	for (int i = 2; i < argc; ++i)
+	{
+		if (!AddPath(argv[i]))
+		{
+			return 1;
+		}
+	}
+
+	int ok = WritePack(argv[1]);
+	for (int i = 0; i < file_count; ++i)
+	{
+		free(files[i].path);
+	}
+	free(files);
+	return ok ? 0 : 1;
+}
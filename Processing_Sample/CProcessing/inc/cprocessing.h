@@ -54,11 +54,18 @@ extern "C"
 // ENGINE:
 //		Functions managing code flow
 CP_API void				CP_Engine_Run						(void);
+CP_API void				CP_Engine_RunHeadless				(unsigned frames);
+CP_API void				CP_Engine_RunThreaded				(void);
+CP_API void				CP_Engine_Benchmark					(FunctionPtr init, FunctionPtr update, FunctionPtr exit, unsigned frames);
+CP_API void				CP_Engine_SetBenchmarkOutput		(const char* filepath);
 CP_API void				CP_Engine_Terminate					(void);
 CP_API void				CP_Engine_SetNextGameState			(FunctionPtr init, FunctionPtr update, FunctionPtr exit);
 CP_API void				CP_Engine_SetNextGameStateForced	(FunctionPtr init, FunctionPtr update, FunctionPtr exit);
 CP_API void				CP_Engine_SetPreUpdateFunction		(FunctionPtr preUpdateFunction);
 CP_API void				CP_Engine_SetPostUpdateFunction		(FunctionPtr postUpdateFunction);
+CP_API void				CP_Engine_SetFixedUpdateFunction	(FunctionPtr fixedUpdateFunction);
+CP_API void				CP_Engine_SetRenderFunction			(RenderFunctionPtr renderFunction);
+CP_API void				CP_Engine_SetFixedTimestep			(float stepsPerSecond, unsigned maxStepsPerFrame);
 
 
 //---------------------------------------------------------
@@ -78,9 +85,14 @@ CP_API void				CP_System_ShowCursor				(CP_BOOL show);
 CP_API unsigned 		CP_System_GetFrameCount				(void);
 CP_API float			CP_System_GetFrameRate				(void);
 CP_API void				CP_System_SetFrameRate				(float fps);
+CP_API void				CP_System_SetFramePacing			(CP_FRAME_PACING pacing);
+CP_API void				CP_System_SetVSync					(CP_VSYNC_MODE mode);
+CP_API void				CP_System_SetFramesInFlight			(unsigned frames);
 CP_API float			CP_System_GetDt						(void);
 CP_API float			CP_System_GetMillis					(void);
 CP_API float			CP_System_GetSeconds				(void);
+CP_API CP_FrameStats	CP_System_GetFrameStats				(void);
+CP_API void				CP_System_SetHitchBudget			(float milliseconds);
 
 
 //---------------------------------------------------------
@@ -145,12 +157,21 @@ CP_API void				CP_Graphics_DrawQuadAdvanced		(float x1, float y1, float x2, floa
 CP_API void				CP_Graphics_BeginShape				(void);
 CP_API void				CP_Graphics_AddVertex				(float x, float y);
 CP_API void				CP_Graphics_EndShape				(void);
+CP_API void				CP_Graphics_DrawRects				(const CP_Vector* positions, const CP_Vector* sizes, const CP_Color* colors, int count);
+CP_API void				CP_Graphics_DrawCircles				(const CP_Vector* positions, const float* diameters, const CP_Color* colors, int count);
+CP_API void				CP_Graphics_DrawLines				(const CP_Vector* starts, const CP_Vector* ends, const CP_Color* colors, int count);
+CP_API void				CP_Graphics_DrawPoints				(const CP_Vector* points, int count);
+CP_API void				CP_Graphics_DrawPolyline			(const CP_Vector* points, int count, CP_BOOL closed);
+CP_API unsigned			CP_Graphics_GetCulledCount			(void);
+CP_API unsigned			CP_Graphics_GetDrawCallCount		(void);
 
 
 //---------------------------------------------------------
 // IMAGE:
 //		All functions related to loading, creating, and drawing images
 CP_API CP_Image			CP_Image_Load						(const char* filepath);
+CP_API CP_Image			CP_Image_LoadAsync					(const char* filepath);
+CP_API CP_IMAGE_STATUS	CP_Image_GetStatus					(CP_Image img);
 CP_API void				CP_Image_Free						(CP_Image* img);
 CP_API int				CP_Image_GetWidth					(CP_Image img);
 CP_API int				CP_Image_GetHeight					(CP_Image img);
@@ -159,8 +180,65 @@ CP_API void				CP_Image_DrawAdvanced				(CP_Image img, float x, float y, float w
 CP_API void				CP_Image_DrawSubImage				(CP_Image img, float x, float y, float w, float h, float u0, float v0, float u1, float v1, int alpha);
 CP_API CP_Image			CP_Image_CreateFromData				(int w, int h, unsigned char* pixelDataInput);
 CP_API CP_Image			CP_Image_Screenshot					(int x, int y, int w, int h);
+CP_API CP_BOOL			CP_Image_ScreenshotAsync			(int x, int y, int w, int h, ScreenshotFunctionPtr callback, void* userdata);
 CP_API void				CP_Image_GetPixelData				(CP_Image img, CP_Color* pixelDataOutput);
 CP_API void				CP_Image_UpdatePixelData			(CP_Image img, CP_Color* pixelDataInput);
+CP_API void				CP_Image_BeginBatch					(void);
+CP_API void				CP_Image_EndBatch					(void);
+CP_API CP_BOOL			CP_Image_CreateAtlas				(const char** filepaths, int count, CP_Image* subImages);
+CP_API CP_BOOL			CP_Image_CreateAtlasFromImages		(const CP_Image* images, int count, CP_Image* subImages);
+CP_API void				CP_Image_SetTextureBudget			(unsigned megabytes);
+CP_API float			CP_Image_GetTextureMemory			(void);
+
+
+//---------------------------------------------------------
+// SHAPE:
+//		Shapes recorded once and redrawn from cached geometry, filled like CP_Graphics_EndShape
+CP_API CP_Shape			CP_Shape_Create						(void);
+CP_API void				CP_Shape_AddVertex					(CP_Shape shape, float x, float y);
+CP_API void				CP_Shape_Draw						(CP_Shape shape);
+CP_API void				CP_Shape_DrawAdvanced				(CP_Shape shape, float x, float y, float degrees);
+CP_API void				CP_Shape_Free						(CP_Shape* shape);
+
+
+//---------------------------------------------------------
+// CANVAS:
+//		Offscreen layers drawn into once and then drawn as images, redrawn only when dirty
+CP_API CP_Canvas		CP_Canvas_Create					(int w, int h);
+CP_API void				CP_Canvas_Free						(CP_Canvas* canvas);
+CP_API void				CP_Canvas_Begin						(CP_Canvas canvas);
+CP_API void				CP_Canvas_End						(void);
+CP_API CP_Image			CP_Canvas_GetImage					(CP_Canvas canvas);
+CP_API void				CP_Canvas_SetDirty					(CP_Canvas canvas);
+CP_API CP_BOOL			CP_Canvas_IsDirty					(CP_Canvas canvas);
+
+
+//---------------------------------------------------------
+// PROFILE:
+//		Timing zones for finding where a frame goes, written out as a Chrome trace
+CP_API void				CP_Profile_Begin					(const char* name);
+CP_API void				CP_Profile_End						(void);
+CP_API CP_BOOL			CP_Profile_Dump						(const char* filepath);
+CP_API void				CP_Profile_SetFrameBudget			(float milliseconds, const char* filepath);
+
+
+//---------------------------------------------------------
+// JOB:
+//		Running work on every core, jobs run on a pool of worker threads started with the engine
+CP_API CP_JobCounter	CP_Job_CreateCounter				(void);
+CP_API void				CP_Job_FreeCounter					(CP_JobCounter* counter);
+CP_API void				CP_Job_Submit						(JobFunctionPtr job, void* data, CP_JobCounter counter);
+CP_API void				CP_Job_SubmitAfter					(CP_JobCounter dependency, JobFunctionPtr job, void* data, CP_JobCounter counter);
+CP_API void				CP_Job_Wait							(CP_JobCounter counter);
+CP_API CP_BOOL			CP_Job_IsDone						(CP_JobCounter counter);
+CP_API int				CP_Job_GetThreadCount				(void);
+CP_API void				CP_ParallelFor						(int begin, int end, int grain, ParallelForFunctionPtr fn, void* userdata);
+
+
+//---------------------------------------------------------
+// PACK:
+//		Images, sounds and fonts loaded straight from memory mapped .cpak files, anything not in a pack loads from disk
+CP_API CP_BOOL			CP_Pack_Open						(const char* filepath);
 
 
 //---------------------------------------------------------
@@ -237,6 +315,10 @@ CP_API CP_Vector		CP_Input_GamepadLeftStick			(void);
 CP_API CP_Vector		CP_Input_GamepadLeftStickAdvanced	(unsigned gamepadIndex);
 CP_API CP_BOOL			CP_Input_GamepadConnected			(void);
 CP_API CP_BOOL			CP_Input_GamepadConnectedAdvanced	(unsigned gamepadIndex);
+CP_API CP_BOOL			CP_Input_StartRecording				(const char* filepath);
+CP_API void				CP_Input_StopRecording				(void);
+CP_API CP_BOOL			CP_Input_Replay						(const char* filepath);
+CP_API CP_BOOL			CP_Input_IsReplaying				(void);
 
 
 //---------------------------------------------------------
@@ -46,13 +46,21 @@ extern "C"
 
 typedef unsigned int	CP_BOOL;
 typedef struct			CP_Image_Struct* CP_Image;
+typedef struct			CP_Shape_Struct* CP_Shape;
+typedef struct			CP_Canvas_Struct* CP_Canvas;
 typedef struct			CP_Sound_Struct* CP_Sound;
 typedef struct			CP_Font_Struct* CP_Font;
+typedef struct			CP_JobCounter_Struct* CP_JobCounter;
+union					CP_Color;
 
 
 //---------------------------------------------------------
 // Function Pointer
 typedef					void(*FunctionPtr)(void);
+typedef					void(*RenderFunctionPtr)(float alpha);
+typedef					void(*JobFunctionPtr)(void* data);
+typedef					void(*ParallelForFunctionPtr)(int begin, int end, void* userdata);
+typedef					void(*ScreenshotFunctionPtr)(const union CP_Color* pixels, int w, int h, void* userdata);
 
 
 //---------------------------------------------------------
@@ -72,6 +80,30 @@ typedef union CP_ColorHSL
 } CP_ColorHSL;
 
 
+//---------------------------------------------------------
+// FRAME PACING:
+//		Start - each frame lasts at least the target frame time from when it started
+//		Cadence - frames end on a fixed cadence, a late frame shortens the next instead of delaying the rest
+typedef enum CP_FRAME_PACING
+{
+	CP_FRAME_PACING_START,		// Default
+	CP_FRAME_PACING_CADENCE
+} CP_FRAME_PACING;
+
+
+//---------------------------------------------------------
+// VSYNC MODE:
+//		Off - frames are shown as soon as they are done, which can tear
+//		On - frames are shown when the display refreshes
+//		Adaptive - like On, a frame that misses the refresh is shown right away instead of waiting for the next
+typedef enum CP_VSYNC_MODE
+{
+	CP_VSYNC_OFF,		// Default
+	CP_VSYNC_ON,
+	CP_VSYNC_ADAPTIVE
+} CP_VSYNC_MODE;
+
+
 //---------------------------------------------------------
 // LINE CAP and JOINT MODE:
 //		Cap controls how the end of the line is drawn
@@ -127,6 +159,19 @@ typedef enum CP_IMAGE_FILTER_MODE
 } CP_IMAGE_FILTER_MODE;
 
 
+//---------------------------------------------------------
+// IMAGE STATUS:
+//		Loading - an image from CP_Image_LoadAsync is still being decoded or uploaded, it draws as a placeholder
+//		Ready - the image is loaded and draws normally
+//		Failed - the image could not be loaded, it is not drawn
+typedef enum CP_IMAGE_STATUS
+{
+	CP_IMAGE_LOADING,
+	CP_IMAGE_READY,
+	CP_IMAGE_FAILED
+} CP_IMAGE_STATUS;
+
+
 //---------------------------------------------------------
 // IMAGE WRAP MODE:
 //		Controls what happens to the edge colors of textures
@@ -400,6 +445,26 @@ typedef enum CP_GAMEPAD
 } CP_GAMEPAD;
 
 
+//---------------------------------------------------------
+// FRAME STATS:
+//		Frame times over the most recent frames in milliseconds, percentiles of the whole frame
+//		and the average time of each phase, hitches are frames slower than the hitch budget
+typedef struct CP_FrameStats
+{
+	unsigned frames;		// frames in the window
+	float average;
+	float p50;
+	float p95;
+	float p99;
+	float max;
+	float update;			// input, sound and the update functions, including tessellation
+	float render;			// submitting the frame to the renderer
+	float swap;				// swapping buffers and polling events
+	float sleep;			// waiting to hold the frame rate
+	unsigned hitches;
+} CP_FrameStats;
+
+
 #ifdef __cplusplus
 }
 #endif
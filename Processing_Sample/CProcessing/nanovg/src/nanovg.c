@@ -417,6 +417,23 @@ void nvgCancelFrame(NVGcontext* ctx)
 	ctx->params.renderCancel(ctx->params.userPtr);
 }
 
+void nvgFlush(NVGcontext* ctx)
+{
+	ctx->params.renderFlush(ctx->params.userPtr);
+}
+
+void nvgViewport(NVGcontext* ctx, int windowWidth, int windowHeight, float devicePixelRatio)
+{
+	nvg__setDevicePixelRatio(ctx, devicePixelRatio);
+	ctx->params.renderViewport(ctx->params.userPtr, windowWidth, windowHeight, devicePixelRatio);
+}
+
+void nvgFrameStats(NVGcontext* ctx, int* drawCalls, int* triangles)
+{
+	if (drawCalls) *drawCalls = ctx->drawCallCount;
+	if (triangles) *triangles = ctx->fillTriCount + ctx->strokeTriCount + ctx->textTriCount;
+}
+
 void nvgEndFrame(NVGcontext* ctx)
 {
 	ctx->params.renderFlush(ctx->params.userPtr);
@@ -794,6 +811,41 @@ void nvgCurrentTransform(NVGcontext* ctx, float* xform)
 	memcpy(xform, state->xform, sizeof(float)*6);
 }
 
+NVGpaint nvgCurrentFillPaint(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->fill;
+}
+
+NVGpaint nvgCurrentStrokePaint(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->stroke;
+}
+
+float nvgCurrentStrokeWidth(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->strokeWidth;
+}
+
+int nvgCurrentLineCap(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->lineCap;
+}
+
+int nvgCurrentLineJoin(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->lineJoin;
+}
+
+float nvgCurrentMiterLimit(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->miterLimit;
+}
+
+int nvgCurrentShapeAntiAlias(NVGcontext* ctx)
+{
+	return ctx->params.edgeAntiAlias && nvg__getState(ctx)->shapeAntiAlias;
+}
+
 void nvgStrokeColor(NVGcontext* ctx, NVGcolor color)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -838,6 +890,16 @@ void nvgTextureWrap(NVGcontext* ctx, int wrapMode)
 	state->textureWrapMode = wrapMode;
 }
 
+int nvgCurrentTextureFilter(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->textureFilterMode;
+}
+
+int nvgCurrentTextureWrap(NVGcontext* ctx)
+{
+	return nvg__getState(ctx)->textureWrapMode;
+}
+
 int nvgCreateImage(NVGcontext* ctx, const char* filename, int imageFlags)
 {
 	int w, h, n, image;
@@ -882,6 +944,19 @@ void nvgUpdateImage(NVGcontext* ctx, int image, const unsigned char* data)
 	ctx->params.renderUpdateTexture(ctx->params.userPtr, image, 0,0, w,h, data);
 }
 
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	int iw, ih;
+	if (ctx->params.renderGetTextureSize(ctx->params.userPtr, image, &iw, &ih) == 0) return;
+	// Clip the region to the image
+	if (x < 0) { w += x; x = 0; }
+	if (y < 0) { h += y; y = 0; }
+	w = nvg__mini(w, iw - x);
+	h = nvg__mini(h, ih - y);
+	if (w <= 0 || h <= 0) return;
+	ctx->params.renderUpdateTexture(ctx->params.userPtr, image, x,y, w,h, data);
+}
+
 void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h)
 {
 	ctx->params.renderGetTextureSize(ctx->params.userPtr, image, w, h);
@@ -1372,20 +1447,68 @@ static void nvg__tesselateBezier(NVGcontext* ctx,
 	nvg__tesselateBezier(ctx, x1234,y1234, x234,y234, x34,y34, x4,y4, level+1, type);
 }
 
-static void nvg__flattenPaths(NVGcontext* ctx)
+// Closes, winds and measures the segments of the paths in the cache.
+static void nvg__measurePaths(NVGcontext* ctx)
 {
 	NVGpathCache* cache = ctx->cache;
-//	NVGstate* state = nvg__getState(ctx);
-	NVGpoint* last;
 	NVGpoint* p0;
 	NVGpoint* p1;
 	NVGpoint* pts;
 	NVGpath* path;
 	int i, j;
+	float area;
+
+	cache->bounds[0] = cache->bounds[1] = 1e6f;
+	cache->bounds[2] = cache->bounds[3] = -1e6f;
+
+	// Calculate the direction and length of line segments.
+	for (j = 0; j < cache->npaths; j++) {
+		path = &cache->paths[j];
+		pts = &cache->points[path->first];
+
+		// If the first and last points are the same, remove the last, mark as closed path.
+		p0 = &pts[path->count-1];
+		p1 = &pts[0];
+		if (nvg__ptEquals(p0->x,p0->y, p1->x,p1->y, ctx->distTol)) {
+			path->count--;
+			p0 = &pts[path->count-1];
+			path->closed = 1;
+		}
+
+		// Enforce winding.
+		if (path->count > 2) {
+			area = nvg__polyArea(pts, path->count);
+			if (path->winding == NVG_CCW && area < 0.0f)
+				nvg__polyReverse(pts, path->count);
+			if (path->winding == NVG_CW && area > 0.0f)
+				nvg__polyReverse(pts, path->count);
+		}
+
+		for(i = 0; i < path->count; i++) {
+			// Calculate segment direction and length
+			p0->dx = p1->x - p0->x;
+			p0->dy = p1->y - p0->y;
+			p0->len = nvg__normalize(&p0->dx, &p0->dy);
+			// Update bounds
+			cache->bounds[0] = nvg__minf(cache->bounds[0], p0->x);
+			cache->bounds[1] = nvg__minf(cache->bounds[1], p0->y);
+			cache->bounds[2] = nvg__maxf(cache->bounds[2], p0->x);
+			cache->bounds[3] = nvg__maxf(cache->bounds[3], p0->y);
+			// Advance
+			p0 = p1++;
+		}
+	}
+}
+
+static void nvg__flattenPaths(NVGcontext* ctx)
+{
+	NVGpathCache* cache = ctx->cache;
+//	NVGstate* state = nvg__getState(ctx);
+	NVGpoint* last;
+	int i;
 	float* cp1;
 	float* cp2;
 	float* p;
-	float area;
 
 	if (cache->npaths > 0)
 		return;
@@ -1429,46 +1552,7 @@ static void nvg__flattenPaths(NVGcontext* ctx)
 		}
 	}
 
-	cache->bounds[0] = cache->bounds[1] = 1e6f;
-	cache->bounds[2] = cache->bounds[3] = -1e6f;
-
-	// Calculate the direction and length of line segments.
-	for (j = 0; j < cache->npaths; j++) {
-		path = &cache->paths[j];
-		pts = &cache->points[path->first];
-
-		// If the first and last points are the same, remove the last, mark as closed path.
-		p0 = &pts[path->count-1];
-		p1 = &pts[0];
-		if (nvg__ptEquals(p0->x,p0->y, p1->x,p1->y, ctx->distTol)) {
-			path->count--;
-			p0 = &pts[path->count-1];
-			path->closed = 1;
-		}
-
-		// Enforce winding.
-		if (path->count > 2) {
-			area = nvg__polyArea(pts, path->count);
-			if (path->winding == NVG_CCW && area < 0.0f)
-				nvg__polyReverse(pts, path->count);
-			if (path->winding == NVG_CW && area > 0.0f)
-				nvg__polyReverse(pts, path->count);
-		}
-
-		for(i = 0; i < path->count; i++) {
-			// Calculate segment direction and length
-			p0->dx = p1->x - p0->x;
-			p0->dy = p1->y - p0->y;
-			p0->len = nvg__normalize(&p0->dx, &p0->dy);
-			// Update bounds
-			cache->bounds[0] = nvg__minf(cache->bounds[0], p0->x);
-			cache->bounds[1] = nvg__minf(cache->bounds[1], p0->y);
-			cache->bounds[2] = nvg__maxf(cache->bounds[2], p0->x);
-			cache->bounds[3] = nvg__maxf(cache->bounds[3], p0->y);
-			// Advance
-			p0 = p1++;
-		}
-	}
+	nvg__measurePaths(ctx);
 }
 
 static int nvg__curveDivs(float r, float arc, float tol)
@@ -2309,6 +2393,54 @@ void nvgFill(NVGcontext* ctx)
 	}
 }
 
+void nvgTriangles(NVGcontext* ctx, NVGpaint paint, const NVGvertex* verts, int nverts)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGvertex* dst;
+	int i;
+
+	nverts -= nverts % 3;
+	if (nverts <= 0) return;
+
+	dst = nvg__allocTempVerts(ctx, nverts);
+	if (dst == NULL) return;
+
+	for (i = 0; i < nverts; i += 3) {
+		NVGvertex* t = &dst[i];
+		float area;
+		nvgTransformPoint(&t[0].x, &t[0].y, state->xform, verts[i].x, verts[i].y);
+		nvgTransformPoint(&t[1].x, &t[1].y, state->xform, verts[i+1].x, verts[i+1].y);
+		nvgTransformPoint(&t[2].x, &t[2].y, state->xform, verts[i+2].x, verts[i+2].y);
+		t[0].u = verts[i].u; t[0].v = verts[i].v;
+		t[1].u = verts[i+1].u; t[1].v = verts[i+1].v;
+		t[2].u = verts[i+2].u; t[2].v = verts[i+2].v;
+		// Back faces are culled by the renderer, so wind every triangle the same way
+		area = (t[1].x - t[0].x) * (t[2].y - t[0].y) - (t[2].x - t[0].x) * (t[1].y - t[0].y);
+		if (area > 0.0f) {
+			NVGvertex tmp = t[1];
+			t[1] = t[2];
+			t[2] = tmp;
+		}
+	}
+
+	// Apply global tint
+	paint.innerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	paint.innerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	paint.innerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+	paint.outerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	paint.outerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	paint.outerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+
+	// Apply global alpha
+	paint.innerColor.a *= state->alpha;
+	paint.outerColor.a *= state->alpha;
+
+	ctx->params.renderTriangles(ctx->params.userPtr, &paint, state->compositeOperation, &state->scissor, dst, nverts);
+
+	ctx->drawCallCount++;
+	ctx->fillTriCount += nverts/3;
+}
+
 void nvgStroke(NVGcontext* ctx)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2358,6 +2490,321 @@ void nvgStroke(NVGcontext* ctx)
 	}
 }
 
+struct NVGshapeGeometry {
+	NVGpath* paths;
+	NVGpath* drawPaths;
+	int npaths;
+	NVGvertex* verts;
+	int nverts;
+	float bounds[4];
+	int valid;
+};
+typedef struct NVGshapeGeometry NVGshapeGeometry;
+
+struct NVGshape {
+	float* points;
+	int npoints;
+
+	// Tolerances in shape coordinates, fixed the first time the shape is drawn
+	int measured;
+	float fringeWidth;
+	float tessTol;
+	float distTol;
+
+	NVGshapeGeometry fill;
+	int fillAntiAlias;
+
+	NVGshapeGeometry stroke;
+	float strokeWidth;
+	int lineCap;
+	int lineJoin;
+	float miterLimit;
+	int strokeClosed;
+	int strokeAntiAlias;
+};
+
+NVGshape* nvgCreateShape(NVGcontext* ctx, const float* points, int npoints)
+{
+	NVGshape* shape;
+	NVG_NOTUSED(ctx);
+
+	if (points == NULL || npoints < 2) return NULL;
+
+	shape = (NVGshape*)malloc(sizeof(NVGshape));
+	if (shape == NULL) return NULL;
+	memset(shape, 0, sizeof(NVGshape));
+
+	shape->points = (float*)malloc(sizeof(float) * 2 * npoints);
+	if (shape->points == NULL) {
+		free(shape);
+		return NULL;
+	}
+	memcpy(shape->points, points, sizeof(float) * 2 * npoints);
+	shape->npoints = npoints;
+
+	return shape;
+}
+
+static void nvg__freeShapeGeometry(NVGshapeGeometry* geom)
+{
+	free(geom->paths);
+	free(geom->drawPaths);
+	free(geom->verts);
+	memset(geom, 0, sizeof(NVGshapeGeometry));
+}
+
+void nvgDeleteShape(NVGcontext* ctx, NVGshape* shape)
+{
+	NVG_NOTUSED(ctx);
+	if (shape == NULL) return;
+	nvg__freeShapeGeometry(&shape->fill);
+	nvg__freeShapeGeometry(&shape->stroke);
+	free(shape->points);
+	free(shape);
+}
+
+// Expands the shape in the path cache and keeps a copy of the resulting paths and vertices.
+static int nvg__tessellateShape(NVGcontext* ctx, NVGshape* shape, NVGshapeGeometry* geom, int closed, int stroke, float fringe)
+{
+	NVGpathCache* cache = ctx->cache;
+	float tessTol = ctx->tessTol;
+	float distTol = ctx->distTol;
+	int i, nverts = 0;
+
+	nvg__freeShapeGeometry(geom);
+
+	// The current path is flattened again from its commands the next time it is drawn
+	nvg__clearPathCache(ctx);
+	ctx->tessTol = shape->tessTol;
+	ctx->distTol = shape->distTol;
+
+	nvg__addPath(ctx);
+	for (i = 0; i < shape->npoints; i++)
+		nvg__addPoint(ctx, shape->points[i*2], shape->points[i*2+1], NVG_PT_CORNER);
+	if (closed)
+		nvg__closePath(ctx);
+	nvg__measurePaths(ctx);
+
+	if (stroke)
+		nvg__expandStroke(ctx, nvg__maxf(shape->strokeWidth, shape->fringeWidth) * 0.5f, fringe, shape->lineCap, shape->lineJoin, shape->miterLimit);
+	else
+		nvg__expandFill(ctx, fringe, NVG_MITER, 2.4f);
+
+	ctx->tessTol = tessTol;
+	ctx->distTol = distTol;
+
+	for (i = 0; i < cache->npaths; i++)
+		nverts += cache->paths[i].nfill + cache->paths[i].nstroke;
+
+	geom->paths = (NVGpath*)malloc(sizeof(NVGpath) * nvg__maxi(cache->npaths, 1));
+	geom->drawPaths = (NVGpath*)malloc(sizeof(NVGpath) * nvg__maxi(cache->npaths, 1));
+	geom->verts = (NVGvertex*)malloc(sizeof(NVGvertex) * nvg__maxi(nverts, 1));
+	if (geom->paths == NULL || geom->drawPaths == NULL || geom->verts == NULL) {
+		nvg__freeShapeGeometry(geom);
+		nvg__clearPathCache(ctx);
+		return 0;
+	}
+
+	// Vertex pointers are rebased onto the shape's own copy
+	nverts = 0;
+	for (i = 0; i < cache->npaths; i++) {
+		NVGpath* path = &geom->paths[i];
+		*path = cache->paths[i];
+		if (path->nfill > 0) {
+			memcpy(&geom->verts[nverts], path->fill, sizeof(NVGvertex) * path->nfill);
+			path->fill = &geom->verts[nverts];
+			nverts += path->nfill;
+		}
+		if (path->nstroke > 0) {
+			memcpy(&geom->verts[nverts], path->stroke, sizeof(NVGvertex) * path->nstroke);
+			path->stroke = &geom->verts[nverts];
+			nverts += path->nstroke;
+		}
+	}
+	geom->npaths = cache->npaths;
+	geom->nverts = nverts;
+	memcpy(geom->bounds, cache->bounds, sizeof(float) * 4);
+	geom->valid = 1;
+
+	nvg__clearPathCache(ctx);
+	return 1;
+}
+
+// Fixes the tolerances of the shape to the current transform the first time it is drawn.
+static void nvg__measureShape(NVGcontext* ctx, NVGshape* shape)
+{
+	float scale;
+	if (shape->measured) return;
+	scale = nvg__getAverageScale(nvg__getState(ctx)->xform);
+	if (scale < 1e-6f) scale = 1.0f;
+	shape->fringeWidth = ctx->fringeWidth / scale;
+	shape->tessTol = ctx->tessTol / scale;
+	shape->distTol = ctx->distTol / scale;
+	shape->measured = 1;
+}
+
+// Transforms the cached geometry into temporary vertices, returns the paths pointing at them.
+static NVGpath* nvg__transformShape(NVGcontext* ctx, NVGshapeGeometry* geom, float* bounds)
+{
+	NVGstate* state = nvg__getState(ctx);
+	const float* t = state->xform;
+	int flip = t[0]*t[3] - t[1]*t[2] < 0.0f;
+	NVGvertex* verts;
+	int i, j;
+
+	verts = nvg__allocTempVerts(ctx, geom->nverts);
+	if (verts == NULL) return NULL;
+
+	for (i = 0; i < geom->nverts; i++) {
+		nvgTransformPoint(&verts[i].x, &verts[i].y, t, geom->verts[i].x, geom->verts[i].y);
+		verts[i].u = geom->verts[i].u;
+		verts[i].v = geom->verts[i].v;
+	}
+
+	for (i = 0; i < geom->npaths; i++) {
+		const NVGpath* src = &geom->paths[i];
+		NVGpath* dst = &geom->drawPaths[i];
+		*dst = *src;
+		if (src->nfill > 0) dst->fill = &verts[src->fill - geom->verts];
+		if (src->nstroke > 0) dst->stroke = &verts[src->stroke - geom->verts];
+
+		// A mirroring transform flips every triangle, the renderer culls them unless the order is flipped back
+		if (flip) {
+			for (j = 0; j < dst->nfill / 2; j++) {
+				NVGvertex tmp = dst->fill[j];
+				dst->fill[j] = dst->fill[dst->nfill - 1 - j];
+				dst->fill[dst->nfill - 1 - j] = tmp;
+			}
+			for (j = 0; j + 1 < dst->nstroke; j += 2) {
+				NVGvertex tmp = dst->stroke[j];
+				dst->stroke[j] = dst->stroke[j+1];
+				dst->stroke[j+1] = tmp;
+			}
+		}
+	}
+
+	bounds[0] = bounds[1] = 1e6f;
+	bounds[2] = bounds[3] = -1e6f;
+	for (i = 0; i < 4; i++) {
+		float x, y;
+		nvgTransformPoint(&x, &y, t, geom->bounds[(i & 1) ? 2 : 0], geom->bounds[(i & 2) ? 3 : 1]);
+		bounds[0] = nvg__minf(bounds[0], x);
+		bounds[1] = nvg__minf(bounds[1], y);
+		bounds[2] = nvg__maxf(bounds[2], x);
+		bounds[3] = nvg__maxf(bounds[3], y);
+	}
+
+	return geom->drawPaths;
+}
+
+void nvgFillShape(NVGcontext* ctx, NVGshape* shape)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpaint fillPaint = state->fill;
+	int antiAlias = ctx->params.edgeAntiAlias && state->shapeAntiAlias;
+	const NVGpath* paths;
+	float bounds[4];
+	int i;
+
+	if (shape == NULL) return;
+	nvg__measureShape(ctx, shape);
+
+	if (!shape->fill.valid || shape->fillAntiAlias != antiAlias) {
+		shape->fillAntiAlias = antiAlias;
+		if (!nvg__tessellateShape(ctx, shape, &shape->fill, 1, 0, antiAlias ? shape->fringeWidth : 0.0f))
+			return;
+	}
+
+	paths = nvg__transformShape(ctx, &shape->fill, bounds);
+	if (paths == NULL) return;
+
+	// Apply global tint
+	fillPaint.innerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	fillPaint.innerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	fillPaint.innerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+	fillPaint.outerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	fillPaint.outerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	fillPaint.outerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+
+	// Apply global alpha
+	fillPaint.innerColor.a *= state->alpha;
+	fillPaint.outerColor.a *= state->alpha;
+	fillPaint.textureFilterMode = state->textureFilterMode;
+	fillPaint.textureWrapMode = state->textureWrapMode;
+
+	ctx->params.renderFill(ctx->params.userPtr, &fillPaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
+						   bounds, paths, shape->fill.npaths);
+
+	// Count triangles
+	for (i = 0; i < shape->fill.npaths; i++) {
+		ctx->fillTriCount += paths[i].nfill-2;
+		ctx->fillTriCount += paths[i].nstroke-2;
+		ctx->drawCallCount += 2;
+	}
+}
+
+void nvgStrokeShape(NVGcontext* ctx, NVGshape* shape, int closed)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float scale = nvg__getAverageScale(state->xform);
+	float strokeWidth = nvg__clampf(state->strokeWidth * scale, 0.0f, 200.0f);
+	NVGpaint strokePaint = state->stroke;
+	int antiAlias = ctx->params.edgeAntiAlias && state->shapeAntiAlias;
+	const NVGpath* paths;
+	float bounds[4];
+	int i;
+
+	if (shape == NULL) return;
+	nvg__measureShape(ctx, shape);
+
+	closed = closed ? 1 : 0;
+	if (!shape->stroke.valid || shape->strokeWidth != state->strokeWidth || shape->lineCap != state->lineCap ||
+		shape->lineJoin != state->lineJoin || shape->miterLimit != state->miterLimit ||
+		shape->strokeClosed != closed || shape->strokeAntiAlias != antiAlias) {
+		shape->strokeWidth = state->strokeWidth;
+		shape->lineCap = state->lineCap;
+		shape->lineJoin = state->lineJoin;
+		shape->miterLimit = state->miterLimit;
+		shape->strokeClosed = closed;
+		shape->strokeAntiAlias = antiAlias;
+		if (!nvg__tessellateShape(ctx, shape, &shape->stroke, closed, 1, antiAlias ? shape->fringeWidth : 0.0f))
+			return;
+	}
+
+	if (strokeWidth < ctx->fringeWidth) {
+		// If the stroke width is less than pixel size, use alpha to emulate coverage.
+		// Since coverage is area, scale by alpha*alpha.
+		float alpha = nvg__clampf(strokeWidth / ctx->fringeWidth, 0.0f, 1.0f);
+		strokePaint.innerColor.a *= alpha*alpha;
+		strokePaint.outerColor.a *= alpha*alpha;
+		strokeWidth = ctx->fringeWidth;
+	}
+
+	paths = nvg__transformShape(ctx, &shape->stroke, bounds);
+	if (paths == NULL) return;
+
+	// Apply global tint
+	strokePaint.innerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	strokePaint.innerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	strokePaint.innerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+	strokePaint.outerColor.r *= nvg__lerpf(1.0f, state->tint.r, state->tint.a);
+	strokePaint.outerColor.g *= nvg__lerpf(1.0f, state->tint.g, state->tint.a);
+	strokePaint.outerColor.b *= nvg__lerpf(1.0f, state->tint.b, state->tint.a);
+
+	// Apply global alpha
+	strokePaint.innerColor.a *= state->alpha;
+	strokePaint.outerColor.a *= state->alpha;
+
+	ctx->params.renderStroke(ctx->params.userPtr, &strokePaint, state->compositeOperation, &state->scissor, ctx->fringeWidth,
+							 strokeWidth, paths, shape->stroke.npaths);
+
+	// Count triangles
+	for (i = 0; i < shape->stroke.npaths; i++) {
+		ctx->strokeTriCount += paths[i].nstroke-2;
+		ctx->drawCallCount++;
+	}
+}
+
 // Add fonts
 int nvgCreateFont(NVGcontext* ctx, const char* name, const char* path)
 {
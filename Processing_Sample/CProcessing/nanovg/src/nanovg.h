@@ -188,6 +188,17 @@ void nvgCancelFrame(NVGcontext* ctx);
 // Ends drawing flushing remaining render state.
 void nvgEndFrame(NVGcontext* ctx);
 
+// Renders the draw calls queued so far without ending the frame, the render state
+// and transform stack are kept. Used before switching render targets mid-frame.
+void nvgFlush(NVGcontext* ctx);
+
+// Changes the size of the window rendered to without ending the frame or resetting
+// the render state. Queued draw calls should be flushed first with nvgFlush().
+void nvgViewport(NVGcontext* ctx, int windowWidth, int windowHeight, float devicePixelRatio);
+
+// Returns the number of render calls and triangles submitted since nvgBeginFrame().
+void nvgFrameStats(NVGcontext* ctx, int* drawCalls, int* triangles);
+
 //
 // Composite operation
 //
@@ -290,6 +301,10 @@ void nvgTextureFilter(NVGcontext* ctx, int filterMode);
 // Sets current texture wrap mode to CLAMP or REPEAT the edge color
 void nvgTextureWrap(NVGcontext* ctx, int wrapMode);
 
+// Returns the current texture filter and wrap modes.
+int nvgCurrentTextureFilter(NVGcontext* ctx);
+int nvgCurrentTextureWrap(NVGcontext* ctx);
+
 // Sets the miter limit of the stroke style.
 // Miter limit controls when a sharp corner is beveled.
 void nvgMiterLimit(NVGcontext* ctx, float limit);
@@ -309,6 +324,19 @@ void nvgLineJoin(NVGcontext* ctx, int join);
 // Already transparent paths will get proportionally more transparent as well.
 void nvgGlobalAlpha(NVGcontext* ctx, float alpha);
 
+// Returns the current fill and stroke styles, solid colors are stored as the paint's inner color.
+NVGpaint nvgCurrentFillPaint(NVGcontext* ctx);
+NVGpaint nvgCurrentStrokePaint(NVGcontext* ctx);
+
+// Returns the current stroke width, line cap, line join and miter limit of the stroke style.
+float nvgCurrentStrokeWidth(NVGcontext* ctx);
+int nvgCurrentLineCap(NVGcontext* ctx);
+int nvgCurrentLineJoin(NVGcontext* ctx);
+float nvgCurrentMiterLimit(NVGcontext* ctx);
+
+// Returns 1 if nvgFill() and nvgStroke() currently draw antialiased edges.
+int nvgCurrentShapeAntiAlias(NVGcontext* ctx);
+
 //
 // Transforms
 //
@@ -422,6 +450,10 @@ int nvgGetImagePixelsRGBA(NVGcontext* ctx, int image, unsigned char* data);
 // Updates image data specified by image handle.
 void nvgUpdateImage(NVGcontext* ctx, int image, const unsigned char* data);
 
+// Updates a region of the image specified by image handle.
+// data holds the pixels of the whole image, only the x,y,w,h region of it is uploaded.
+void nvgUpdateImageRegion(NVGcontext* ctx, int image, int x, int y, int w, int h, const unsigned char* data);
+
 // Returns the dimensions of a created image.
 void nvgImageSize(NVGcontext* ctx, int image, int* w, int* h);
 
@@ -548,6 +580,35 @@ void nvgFill(NVGcontext* ctx);
 // Fills the current path with current stroke style.
 void nvgStroke(NVGcontext* ctx);
 
+// Draws a list of triangles filled with the specified paint, which is expected to be an image pattern.
+// Vertex positions are transformed by the current transform, u,v are texture coordinates of the paint image.
+// All the triangles are submitted as one draw call, they are not antialiased by nanovg.
+struct NVGvertex;
+void nvgTriangles(NVGcontext* ctx, NVGpaint paint, const struct NVGvertex* verts, int nverts);
+
+//
+// Retained Shapes
+//
+// A shape is a polygon whose fill and stroke geometry is tessellated once in the shape's own
+// coordinates and then drawn under any transform without being tessellated again.
+// The stroke is tessellated again only when the stroke width, line cap, line join, miter limit
+// or the closing of the outline change. Antialiased edges are sized for the scale of the
+// transform the shape was first drawn with.
+
+typedef struct NVGshape NVGshape;
+
+// Creates a shape from npoints x,y pairs. Returns NULL on failure.
+NVGshape* nvgCreateShape(NVGcontext* ctx, const float* points, int npoints);
+
+// Deletes a shape created with nvgCreateShape().
+void nvgDeleteShape(NVGcontext* ctx, NVGshape* shape);
+
+// Fills the closed shape with the current fill style.
+void nvgFillShape(NVGcontext* ctx, NVGshape* shape);
+
+// Strokes the outline of the shape with the current stroke style, closed joins the last point to the first.
+void nvgStrokeShape(NVGcontext* ctx, NVGshape* shape, int closed);
+
 
 //
 // Text
@@ -32,6 +32,9 @@ enum NVGcreateFlags {
 	NVG_STENCIL_STROKES	= 1<<1,
 	// Flag indicating that additional debug checks are done.
 	NVG_DEBUG 			= 1<<2,
+	// Flag indicating that calls sharing a texture, blend mode and paint are drawn together. Calls
+	// are moved next to earlier compatible ones when they do not overlap anything in between.
+	NVG_MERGE_DRAWS		= 1<<3,
 };
 
 #if defined NANOVG_GL2_IMPLEMENTATION
@@ -51,6 +54,14 @@ enum NVGcreateFlags {
 
 #define NANOVG_GL_USE_STATE_FILTER (1)
 
+// Vertices and uniforms are written straight into persistently mapped ring buffers when the
+// context supports buffer storage (GL 4.4), otherwise they are uploaded with glBufferData.
+#if defined NANOVG_GL3 && defined GL_MAP_PERSISTENT_BIT
+#  define NANOVG_GL_USE_BUFFER_STORAGE 1
+#else
+#  define NANOVG_GL_USE_BUFFER_STORAGE 0
+#endif
+
 // Creates NanoVG contexts for different OpenGL (ES) versions.
 // Flags should be combination of the create flags above.
 
@@ -61,6 +72,7 @@ void nvgDeleteGL2(NVGcontext* ctx);
 
 int nvglCreateImageFromHandleGL2(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGL2(NVGcontext* ctx, int image);
+int nvglDrawCountGL2(NVGcontext* ctx);
 
 #endif
 
@@ -71,6 +83,7 @@ void nvgDeleteGL3(NVGcontext* ctx);
 
 int nvglCreateImageFromHandleGL3(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGL3(NVGcontext* ctx, int image);
+int nvglDrawCountGL3(NVGcontext* ctx);
 
 #endif
 
@@ -81,6 +94,7 @@ void nvgDeleteGLES2(NVGcontext* ctx);
 
 int nvglCreateImageFromHandleGLES2(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGLES2(NVGcontext* ctx, int image);
+int nvglDrawCountGLES2(NVGcontext* ctx);
 
 #endif
 
@@ -91,6 +105,7 @@ void nvgDeleteGLES3(NVGcontext* ctx);
 
 int nvglCreateImageFromHandleGLES3(NVGcontext* ctx, GLuint textureId, int w, int h, int flags);
 GLuint nvglImageHandleGLES3(NVGcontext* ctx, int image);
+int nvglDrawCountGLES3(NVGcontext* ctx);
 
 #endif
 
@@ -191,6 +206,8 @@ struct GLNVGcall {
 	int textureFilterMode;
 	int textureWrapMode;
 	GLNVGblend blendFunc;
+	float bounds[4];				// what the call draws over, only set when merging draws
+	unsigned long long paintKey;	// hash of the paint uniforms of fills and triangles
 };
 typedef struct GLNVGcall GLNVGcall;
 
@@ -243,6 +260,38 @@ struct GLNVGfragUniforms {
 };
 typedef struct GLNVGfragUniforms GLNVGfragUniforms;
 
+#if NANOVG_GL_USE_BUFFER_STORAGE
+#define GLNVG_RING_VERTS	(256 * 1024)	// initial ring sizes, grown when a flush needs more
+#define GLNVG_RING_UNIFORMS	(8 * 1024)
+#define GLNVG_MAX_FENCES	8
+#define GLNVG_FENCE_TIMEOUT	1000000000ull	// nanoseconds
+
+// A buffer written front to back and wrapped around, space is reused once the GPU has
+// finished the flush that drew from it. Byte counts only ever grow, the space in use is
+// the difference between what was allocated and what was retired.
+struct GLNVGring {
+	GLuint buf;
+	GLenum target;
+	unsigned char* data;	// mapped for as long as the buffer exists
+	int size;
+	int head;				// offset of the next allocation
+	int start;				// offset of the first allocation since the last flush
+	long long allocated;	// bytes allocated, including ends skipped when wrapping
+	long long flushed;		// allocated at the last flush
+	long long retired;		// bytes the GPU is done with
+};
+typedef struct GLNVGring GLNVGring;
+
+// Marks the end of a flush in the command stream, the rings up to where they were
+// allocated at the time are free once it is signaled
+struct GLNVGfence {
+	GLsync sync;
+	long long verts;
+	long long uniforms;
+};
+typedef struct GLNVGfence GLNVGfence;
+#endif
+
 struct GLNVGcontext {
 	GLNVGshader shader;
 	GLNVGtexture* textures;
@@ -274,6 +323,22 @@ struct GLNVGcontext {
 	int cuniforms;
 	int nuniforms;
 
+	// Draw merging
+	int* order;
+	int corder;
+	GLint* firsts;
+	GLsizei* counts;
+	int cranges;
+	int drawCount;
+
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	// verts and uniforms point into the rings while they are in use
+	GLNVGring vertRing;
+	GLNVGring fragRing;
+	GLNVGfence fences[GLNVG_MAX_FENCES];
+	int nfences;
+#endif
+
 	// cached state
 	#if NANOVG_GL_USE_STATE_FILTER
 	GLuint boundTexture;
@@ -287,6 +352,8 @@ struct GLNVGcontext {
 typedef struct GLNVGcontext GLNVGcontext;
 
 static int glnvg__maxi(int a, int b) { return a > b ? a : b; }
+static float glnvg__minf(float a, float b) { return a < b ? a : b; }
+static float glnvg__maxf(float a, float b) { return a > b ? a : b; }
 
 #ifdef NANOVG_GLES2
 static unsigned int glnvg__nearestPow2(unsigned int num)
@@ -551,6 +618,188 @@ static void glnvg__getUniforms(GLNVGshader* shader)
 #endif
 }
 
+static int glnvg__usingRings(GLNVGcontext* gl)
+{
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	return gl->vertRing.data != NULL;
+#else
+	NVG_NOTUSED(gl);
+	return 0;
+#endif
+}
+
+static GLuint glnvg__vertBuffer(GLNVGcontext* gl)
+{
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) return gl->vertRing.buf;
+#endif
+	return gl->vertBuf;
+}
+
+#if NANOVG_GL_USE_UNIFORMBUFFER
+static GLuint glnvg__fragBuffer(GLNVGcontext* gl)
+{
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) return gl->fragRing.buf;
+#endif
+	return gl->fragBuf;
+}
+#endif
+
+#if NANOVG_GL_USE_BUFFER_STORAGE
+static int glnvg__ringCreate(GLNVGring* ring, GLenum target, int size)
+{
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	memset(ring, 0, sizeof(GLNVGring));
+	glGenBuffers(1, &ring->buf);
+	glBindBuffer(target, ring->buf);
+	glBufferStorage(target, size, NULL, flags);
+	ring->data = (unsigned char*)glMapBufferRange(target, 0, size, flags);
+	glBindBuffer(target, 0);
+	if (ring->data == NULL) {
+		glDeleteBuffers(1, &ring->buf);
+		ring->buf = 0;
+		return 0;
+	}
+	ring->target = target;
+	ring->size = size;
+	return 1;
+}
+
+static void glnvg__ringDelete(GLNVGring* ring)
+{
+	if (ring->buf == 0) return;
+	glBindBuffer(ring->target, ring->buf);
+	glUnmapBuffer(ring->target);
+	glBindBuffer(ring->target, 0);
+	glDeleteBuffers(1, &ring->buf);
+	ring->buf = 0;
+	ring->data = NULL;
+}
+
+// Waits for the GPU to finish the oldest flush still in flight and frees the ring space it
+// used. Returns 0 when nothing is in flight.
+static int glnvg__retireFence(GLNVGcontext* gl)
+{
+	GLNVGfence* fence = &gl->fences[0];
+	if (gl->nfences == 0) return 0;
+
+	// a fence that is stuck for this long is given up on
+	glClientWaitSync(fence->sync, GL_SYNC_FLUSH_COMMANDS_BIT, GLNVG_FENCE_TIMEOUT);
+	glDeleteSync(fence->sync);
+	gl->vertRing.retired = fence->verts;
+	gl->fragRing.retired = fence->uniforms;
+
+	gl->nfences--;
+	memmove(&gl->fences[0], &gl->fences[1], sizeof(GLNVGfence) * gl->nfences);
+	return 1;
+}
+
+// Offsets recorded before a ring grows are moved along with the data, unit is the size of
+// what the offset counts. Offsets outside the ring have not been set yet and are left alone.
+static int glnvg__ringRelocate(const GLNVGring* ring, int offset, int unit)
+{
+	int bytes;
+	if (offset < 0 || offset >= ring->size / unit) return offset;
+	bytes = offset * unit;
+	bytes = bytes >= ring->start ? bytes - ring->start : bytes + ring->size - ring->start;
+	return bytes / unit;
+}
+
+// Replaces the ring with one big enough for everything since the last flush plus n bytes,
+// the pending data is moved to the start of it. Only called with nothing in flight.
+static int glnvg__ringGrow(GLNVGcontext* gl, GLNVGring* ring, int n)
+{
+	GLNVGring grown;
+	int pending = (int)(ring->allocated - ring->flushed);
+	int tail = ring->size - ring->start;
+	int size = ring->size * 2;
+	int i;
+
+	while (size < pending + n) size *= 2;
+	if (!glnvg__ringCreate(&grown, ring->target, size)) return 0;
+
+	if (pending <= tail) {
+		memcpy(grown.data, ring->data + ring->start, pending);
+	} else {
+		memcpy(grown.data, ring->data + ring->start, tail);
+		memcpy(grown.data + tail, ring->data, pending - tail);
+	}
+
+	if (ring == &gl->vertRing) {
+		for (i = 0; i < gl->ncalls; i++)
+			gl->calls[i].triangleOffset = glnvg__ringRelocate(ring, gl->calls[i].triangleOffset, (int)sizeof(NVGvertex));
+		for (i = 0; i < gl->npaths; i++) {
+			gl->paths[i].fillOffset = glnvg__ringRelocate(ring, gl->paths[i].fillOffset, (int)sizeof(NVGvertex));
+			gl->paths[i].strokeOffset = glnvg__ringRelocate(ring, gl->paths[i].strokeOffset, (int)sizeof(NVGvertex));
+		}
+	} else {
+		for (i = 0; i < gl->ncalls; i++)
+			gl->calls[i].uniformOffset = glnvg__ringRelocate(ring, gl->calls[i].uniformOffset, 1);
+	}
+
+	glnvg__ringDelete(ring);
+	ring->buf = grown.buf;
+	ring->data = grown.data;
+	ring->size = grown.size;
+	ring->head = pending;
+	ring->start = 0;
+	ring->retired = ring->flushed;
+	return 1;
+}
+
+// Returns the offset of n contiguous bytes in the ring, waiting for old flushes to finish
+// when it is full and growing it when that is not enough. -1 when out of memory.
+static int glnvg__ringAlloc(GLNVGcontext* gl, GLNVGring* ring, int n)
+{
+	for (;;) {
+		// an allocation that does not fit before the end of the buffer starts over at the front
+		int skip = ring->head + n > ring->size ? ring->size - ring->head : 0;
+		int offset = skip > 0 ? 0 : ring->head;
+		if (ring->allocated + skip + n - ring->retired <= ring->size) {
+			ring->allocated += skip + n;
+			ring->head = offset + n == ring->size ? 0 : offset + n;
+			return offset;
+		}
+		if (!glnvg__retireFence(gl) && !glnvg__ringGrow(gl, ring, n))
+			return -1;
+	}
+}
+
+// Fences the flush that was just drawn, its ring space is reused once the GPU is done with it
+static void glnvg__ringFence(GLNVGcontext* gl)
+{
+	GLNVGfence* fence;
+	if (gl->nfences == GLNVG_MAX_FENCES) glnvg__retireFence(gl);
+
+	fence = &gl->fences[gl->nfences];
+	fence->sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	fence->verts = gl->vertRing.allocated;
+	fence->uniforms = gl->fragRing.allocated;
+	if (fence->sync != NULL) {
+		gl->nfences++;
+	} else {
+		glFinish();
+		gl->vertRing.retired = gl->vertRing.allocated;
+		gl->fragRing.retired = gl->fragRing.allocated;
+	}
+
+	gl->vertRing.start = gl->vertRing.head;
+	gl->vertRing.flushed = gl->vertRing.allocated;
+	gl->fragRing.start = gl->fragRing.head;
+	gl->fragRing.flushed = gl->fragRing.allocated;
+}
+
+// Frees everything allocated since the last flush, nothing was drawn with it
+static void glnvg__ringRewind(GLNVGcontext* gl)
+{
+	gl->vertRing.head = gl->vertRing.start;
+	gl->vertRing.allocated = gl->vertRing.flushed;
+	gl->fragRing.head = gl->fragRing.start;
+	gl->fragRing.allocated = gl->fragRing.flushed;
+}
+#endif
+
 static int glnvg__renderCreate(void* uptr)
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
@@ -751,6 +1000,16 @@ static int glnvg__renderCreate(void* uptr)
 #endif
 	gl->fragSize = sizeof(GLNVGfragUniforms) + align - sizeof(GLNVGfragUniforms) % align;
 
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (GLAD_GL_VERSION_4_4) {
+		if (!glnvg__ringCreate(&gl->vertRing, GL_ARRAY_BUFFER, GLNVG_RING_VERTS * (int)sizeof(NVGvertex)) ||
+			!glnvg__ringCreate(&gl->fragRing, GL_UNIFORM_BUFFER, GLNVG_RING_UNIFORMS * gl->fragSize)) {
+			glnvg__ringDelete(&gl->vertRing);
+			glnvg__ringDelete(&gl->fragRing);
+		}
+	}
+#endif
+
 	glnvg__checkError(gl, "create done");
 
 	glFinish();
@@ -1039,7 +1298,7 @@ static GLNVGfragUniforms* nvg__fragUniformPtr(GLNVGcontext* gl, int i);
 static void glnvg__setUniforms(GLNVGcontext* gl, int uniformOffset, int image)
 {
 #if NANOVG_GL_USE_UNIFORMBUFFER
-	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, gl->fragBuf, uniformOffset, sizeof(GLNVGfragUniforms));
+	glBindBufferRange(GL_UNIFORM_BUFFER, GLNVG_FRAG_BINDING, glnvg__fragBuffer(gl), uniformOffset, sizeof(GLNVGfragUniforms));
 #else
 	GLNVGfragUniforms* frag = nvg__fragUniformPtr(gl, uniformOffset);
 	glUniform4fv(gl->shader.loc[GLNVG_LOC_FRAG], NANOVG_GL_UNIFORMARRAY_SIZE, &(frag->uniformArray[0][0]));
@@ -1065,6 +1324,12 @@ static void glnvg__renderViewport(void* uptr, int width, int height, float devic
 	gl->view[1] = (float)height;
 }
 
+static void glnvg__drawArrays(GLNVGcontext* gl, GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays(mode, first, count);
+	gl->drawCount++;
+}
+
 static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 {
 	GLNVGpath* paths = &gl->paths[call->pathOffset];
@@ -1084,7 +1349,7 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 	glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
 	glDisable(GL_CULL_FACE);
 	for (i = 0; i < npaths; i++)
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
 	glEnable(GL_CULL_FACE);
 
 	// Draw anti-aliased pixels
@@ -1100,13 +1365,13 @@ static void glnvg__fill(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		// Draw fringes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 
 	// Draw fill
 	glnvg__stencilFunc(gl, GL_NOTEQUAL, 0x0, 0xff);
 	glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
-	glDrawArrays(GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, call->triangleOffset, call->triangleCount);
 
 	glDisable(GL_STENCIL_TEST);
 }
@@ -1122,11 +1387,11 @@ static void glnvg__convexFill(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__setTextureWrap(call->textureWrapMode);
 
 	for (i = 0; i < npaths; i++)
-		glDrawArrays(GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
+		glnvg__drawArrays(gl, GL_TRIANGLE_FAN, paths[i].fillOffset, paths[i].fillCount);
 	if (gl->flags & NVG_ANTIALIAS) {
 		// Draw fringes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 }
 
@@ -1146,14 +1411,14 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__setUniforms(gl, call->uniformOffset + gl->fragSize, call->image);
 		glnvg__checkError(gl, "stroke fill 0");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Draw anti-aliased pixels.
 		glnvg__setUniforms(gl, call->uniformOffset, call->image);
 		glnvg__stencilFunc(gl, GL_EQUAL, 0x00, 0xff);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 
 		// Clear stencil buffer.
 		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
@@ -1161,7 +1426,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
 		glnvg__checkError(gl, "stroke fill 1");
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
 		glDisable(GL_STENCIL_TEST);
@@ -1173,7 +1438,7 @@ static void glnvg__stroke(GLNVGcontext* gl, GLNVGcall* call)
 		glnvg__checkError(gl, "stroke fill");
 		// Draw Strokes
 		for (i = 0; i < npaths; i++)
-			glDrawArrays(GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+			glnvg__drawArrays(gl, GL_TRIANGLE_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
 	}
 }
 
@@ -1182,11 +1447,142 @@ static void glnvg__triangles(GLNVGcontext* gl, GLNVGcall* call)
 	glnvg__setUniforms(gl, call->uniformOffset, call->image);
 	glnvg__checkError(gl, "triangles fill");
 
-	glDrawArrays(GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+	glnvg__drawArrays(gl, GL_TRIANGLES, call->triangleOffset, call->triangleCount);
+}
+
+#if defined NANOVG_GL2 || defined NANOVG_GL3
+#define GLNVG_MERGE_WINDOW 64	// how far back a call looks for one to be drawn with
+
+static int glnvg__boundsOverlap(const float* a, const float* b)
+{
+	return a[0] <= b[2] && b[0] <= a[2] && a[1] <= b[3] && b[1] <= a[3];
+}
+
+// Calls can be drawn together when they are fills or triangles with the same state and paint
+static int glnvg__canMerge(const GLNVGcall* a, const GLNVGcall* b)
+{
+	return a->type == b->type && (a->type == GLNVG_CONVEXFILL || a->type == GLNVG_TRIANGLES) &&
+		a->image == b->image && a->paintKey == b->paintKey &&
+		a->textureFilterMode == b->textureFilterMode && a->textureWrapMode == b->textureWrapMode &&
+		memcmp(&a->blendFunc, &b->blendFunc, sizeof(GLNVGblend)) == 0;
+}
+
+// Orders the calls so compatible ones are next to each other. A call only moves in front of
+// calls it does not overlap, so everything that overlaps is still drawn in painter's order.
+static int glnvg__sortCalls(GLNVGcontext* gl)
+{
+	int i, j, n = 0;
+	if (gl->ncalls > gl->corder) {
+		int* order = (int*)realloc(gl->order, sizeof(int) * gl->ncalls);
+		if (order == NULL) return 0;
+		gl->order = order;
+		gl->corder = gl->ncalls;
+	}
+
+	for (i = 0; i < gl->ncalls; i++) {
+		GLNVGcall* call = &gl->calls[i];
+		int at = n;
+		if (call->type == GLNVG_CONVEXFILL || call->type == GLNVG_TRIANGLES) {
+			for (j = n - 1; j >= 0 && j >= n - GLNVG_MERGE_WINDOW; j--) {
+				GLNVGcall* other = &gl->calls[gl->order[j]];
+				if (glnvg__canMerge(other, call)) {
+					at = j + 1;
+					break;
+				}
+				if (glnvg__boundsOverlap(other->bounds, call->bounds))
+					break;
+			}
+		}
+		memmove(&gl->order[at + 1], &gl->order[at], sizeof(int) * (n - at));
+		gl->order[at] = i;
+		n++;
+	}
+	return 1;
+}
+
+static int glnvg__addRange(GLNVGcontext* gl, int nranges, int first, int count, int join)
+{
+	if (count <= 0) return nranges;
+	// triangle lists that follow each other in the buffer are one range
+	if (join && nranges > 0 && gl->firsts[nranges-1] + gl->counts[nranges-1] == first) {
+		gl->counts[nranges-1] += count;
+		return nranges;
+	}
+	if (nranges + 1 > gl->cranges) {
+		int cranges = glnvg__maxi(nranges + 1, 128) + gl->cranges/2; // 1.5x Overallocate
+		GLint* firsts = (GLint*)realloc(gl->firsts, sizeof(GLint) * cranges);
+		GLsizei* counts;
+		if (firsts == NULL) return nranges;
+		gl->firsts = firsts;
+		counts = (GLsizei*)realloc(gl->counts, sizeof(GLsizei) * cranges);
+		if (counts == NULL) return nranges;
+		gl->counts = counts;
+		gl->cranges = cranges;
+	}
+	gl->firsts[nranges] = first;
+	gl->counts[nranges] = count;
+	return nranges + 1;
+}
+
+static void glnvg__multiDrawArrays(GLNVGcontext* gl, GLenum mode, int nranges)
+{
+	if (nranges == 1) {
+		glnvg__drawArrays(gl, mode, gl->firsts[0], gl->counts[0]);
+	} else if (nranges > 1) {
+		glMultiDrawArrays(mode, gl->firsts, gl->counts, nranges);
+		gl->drawCount++;
+	}
+}
+
+// Draws compatible calls with the uniforms of the first, the same draws they would make on
+// their own. Fills are only grouped when they do not overlap, their fringes come after the fills.
+static void glnvg__mergedCalls(GLNVGcontext* gl, const int* order, int ncalls)
+{
+	GLNVGcall* first = &gl->calls[order[0]];
+	int i, j, nranges = 0;
+
+	glnvg__setUniforms(gl, first->uniformOffset, first->image);
+	glnvg__checkError(gl, "merged calls");
+
+	if (first->type == GLNVG_TRIANGLES) {
+		for (i = 0; i < ncalls; i++) {
+			GLNVGcall* call = &gl->calls[order[i]];
+			nranges = glnvg__addRange(gl, nranges, call->triangleOffset, call->triangleCount, 1);
+		}
+		glnvg__multiDrawArrays(gl, GL_TRIANGLES, nranges);
+		return;
+	}
+
+	glnvg__setTextureFilter(first->textureFilterMode);
+	glnvg__setTextureWrap(first->textureWrapMode);
+	for (i = 0; i < ncalls; i++) {
+		GLNVGcall* call = &gl->calls[order[i]];
+		for (j = 0; j < call->pathCount; j++) {
+			GLNVGpath* path = &gl->paths[call->pathOffset + j];
+			nranges = glnvg__addRange(gl, nranges, path->fillOffset, path->fillCount, 0);
+		}
+	}
+	glnvg__multiDrawArrays(gl, GL_TRIANGLE_FAN, nranges);
+
+	if (gl->flags & NVG_ANTIALIAS) {
+		nranges = 0;
+		for (i = 0; i < ncalls; i++) {
+			GLNVGcall* call = &gl->calls[order[i]];
+			for (j = 0; j < call->pathCount; j++) {
+				GLNVGpath* path = &gl->paths[call->pathOffset + j];
+				nranges = glnvg__addRange(gl, nranges, path->strokeOffset, path->strokeCount, 0);
+			}
+		}
+		glnvg__multiDrawArrays(gl, GL_TRIANGLE_STRIP, nranges);
+	}
 }
+#endif
 
 static void glnvg__renderCancel(void* uptr) {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) glnvg__ringRewind(gl);
+#endif
 	gl->nverts = 0;
 	gl->npaths = 0;
 	gl->ncalls = 0;
@@ -1292,17 +1688,19 @@ static void glnvg__renderFlush(void* uptr)
 		#endif
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
-		// Upload ubo for frag shaders
-		glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
-		glBufferData(GL_UNIFORM_BUFFER, gl->nuniforms * gl->fragSize, gl->uniforms, GL_STREAM_DRAW);
+		// Upload ubo for frag shaders, the rings were written to directly
+		glBindBuffer(GL_UNIFORM_BUFFER, glnvg__fragBuffer(gl));
+		if (!glnvg__usingRings(gl))
+			glBufferData(GL_UNIFORM_BUFFER, gl->nuniforms * gl->fragSize, gl->uniforms, GL_STREAM_DRAW);
 #endif
 
 		// Upload vertex data
 #if defined NANOVG_GL3
 		glBindVertexArray(gl->vertArr);
 #endif
-		glBindBuffer(GL_ARRAY_BUFFER, gl->vertBuf);
-		glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, glnvg__vertBuffer(gl));
+		if (!glnvg__usingRings(gl))
+			glBufferData(GL_ARRAY_BUFFER, gl->nverts * sizeof(NVGvertex), gl->verts, GL_STREAM_DRAW);
 		glEnableVertexAttribArray(0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(NVGvertex), (const GLvoid*)(size_t)0);
@@ -1313,9 +1711,41 @@ static void glnvg__renderFlush(void* uptr)
 		glUniform2fv(gl->shader.loc[GLNVG_LOC_VIEWSIZE], 1, gl->view);
 
 #if NANOVG_GL_USE_UNIFORMBUFFER
-		glBindBuffer(GL_UNIFORM_BUFFER, gl->fragBuf);
+		glBindBuffer(GL_UNIFORM_BUFFER, glnvg__fragBuffer(gl));
 #endif
 
+#if defined NANOVG_GL2 || defined NANOVG_GL3
+		if ((gl->flags & NVG_MERGE_DRAWS) && glnvg__sortCalls(gl)) {
+			float bounds[4];
+			int j;
+			for (i = 0; i < gl->ncalls; i = j) {
+				GLNVGcall* call = &gl->calls[gl->order[i]];
+				memcpy(bounds, call->bounds, sizeof(bounds));
+				for (j = i + 1; j < gl->ncalls; j++) {
+					GLNVGcall* next = &gl->calls[gl->order[j]];
+					if (!glnvg__canMerge(call, next) ||
+						(call->type == GLNVG_CONVEXFILL && glnvg__boundsOverlap(bounds, next->bounds)))
+						break;
+					bounds[0] = glnvg__minf(bounds[0], next->bounds[0]);
+					bounds[1] = glnvg__minf(bounds[1], next->bounds[1]);
+					bounds[2] = glnvg__maxf(bounds[2], next->bounds[2]);
+					bounds[3] = glnvg__maxf(bounds[3], next->bounds[3]);
+				}
+
+				glnvg__blendFuncSeparate(gl, &call->blendFunc);
+				if (j - i > 1)
+					glnvg__mergedCalls(gl, &gl->order[i], j - i);
+				else if (call->type == GLNVG_FILL)
+					glnvg__fill(gl, call);
+				else if (call->type == GLNVG_CONVEXFILL)
+					glnvg__convexFill(gl, call);
+				else if (call->type == GLNVG_STROKE)
+					glnvg__stroke(gl, call);
+				else if (call->type == GLNVG_TRIANGLES)
+					glnvg__triangles(gl, call);
+			}
+		} else
+#endif
 		for (i = 0; i < gl->ncalls; i++) {
 			GLNVGcall* call = &gl->calls[i];
 			glnvg__blendFuncSeparate(gl, &call->blendFunc);
@@ -1340,6 +1770,15 @@ static void glnvg__renderFlush(void* uptr)
 		glnvg__bindTexture(gl, 0);
 	}
 
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) {
+		if (gl->ncalls > 0)
+			glnvg__ringFence(gl);
+		else
+			glnvg__ringRewind(gl);
+	}
+#endif
+
 	// Reset calls
 	gl->nverts = 0;
 	gl->npaths = 0;
@@ -1392,6 +1831,13 @@ static int glnvg__allocPaths(GLNVGcontext* gl, int n)
 static int glnvg__allocVerts(GLNVGcontext* gl, int n)
 {
 	int ret = 0;
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) {
+		ret = glnvg__ringAlloc(gl, &gl->vertRing, n * (int)sizeof(NVGvertex));
+		gl->verts = (NVGvertex*)gl->vertRing.data; // moves when the ring grows
+		return ret == -1 ? -1 : ret / (int)sizeof(NVGvertex);
+	}
+#endif
 	if (gl->nverts+n > gl->cverts) {
 		NVGvertex* verts;
 		int cverts = glnvg__maxi(gl->nverts + n, 4096) + gl->cverts/2; // 1.5x Overallocate
@@ -1408,6 +1854,13 @@ static int glnvg__allocVerts(GLNVGcontext* gl, int n)
 static int glnvg__allocFragUniforms(GLNVGcontext* gl, int n)
 {
 	int ret = 0, structSize = gl->fragSize;
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) {
+		ret = glnvg__ringAlloc(gl, &gl->fragRing, n * structSize);
+		gl->uniforms = gl->fragRing.data;
+		return ret;
+	}
+#endif
 	if (gl->nuniforms+n > gl->cuniforms) {
 		unsigned char* uniforms;
 		int cuniforms = glnvg__maxi(gl->nuniforms+n, 128) + gl->cuniforms/2; // 1.5x Overallocate
@@ -1434,6 +1887,32 @@ static void glnvg__vset(NVGvertex* vtx, float x, float y, float u, float v)
 	vtx->v = v;
 }
 
+static void glnvg__vertBounds(float* bounds, const NVGvertex* verts, int nverts)
+{
+	int i;
+	for (i = 0; i < nverts; i++) {
+		bounds[0] = glnvg__minf(bounds[0], verts[i].x);
+		bounds[1] = glnvg__minf(bounds[1], verts[i].y);
+		bounds[2] = glnvg__maxf(bounds[2], verts[i].x);
+		bounds[3] = glnvg__maxf(bounds[3], verts[i].y);
+	}
+}
+
+// Writes the uniforms of a call that can be merged, keyed by an FNV-1a hash of their bytes so
+// calls can be compared without reading back from the uniform buffer
+static void glnvg__setPaint(GLNVGcontext* gl, GLNVGcall* call, const GLNVGfragUniforms* frag)
+{
+	memcpy(nvg__fragUniformPtr(gl, call->uniformOffset), frag, sizeof(GLNVGfragUniforms));
+	if (gl->flags & NVG_MERGE_DRAWS) {
+		const unsigned char* bytes = (const unsigned char*)frag;
+		unsigned long long key = 14695981039346656037ull;
+		size_t i;
+		for (i = 0; i < sizeof(GLNVGfragUniforms); i++)
+			key = (key ^ bytes[i]) * 1099511628211ull;
+		call->paintKey = key;
+	}
+}
+
 static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
 							  const float* bounds, const NVGpath* paths, int npaths)
 {
@@ -1454,6 +1933,10 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 	call->blendFunc = glnvg__blendCompositeOperation(compositeOperation);
 	call->textureFilterMode = paint->textureFilterMode;
 	call->textureWrapMode = paint->textureWrapMode;
+	call->bounds[0] = bounds[0] - fringe;
+	call->bounds[1] = bounds[1] - fringe;
+	call->bounds[2] = bounds[2] + fringe;
+	call->bounds[3] = bounds[3] + fringe;
 
 	if (npaths == 1 && paths[0].convex)
 	{
@@ -1504,10 +1987,12 @@ static void glnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperation
 		// Fill shader
 		glnvg__convertPaint(gl, nvg__fragUniformPtr(gl, call->uniformOffset + gl->fragSize), paint, scissor, fringe, fringe, -1.0f);
 	} else {
+		GLNVGfragUniforms fill;
 		call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
 		if (call->uniformOffset == -1) goto error;
 		// Fill shader
-		glnvg__convertPaint(gl, nvg__fragUniformPtr(gl, call->uniformOffset), paint, scissor, fringe, fringe, -1.0f);
+		glnvg__convertPaint(gl, &fill, paint, scissor, fringe, fringe, -1.0f);
+		glnvg__setPaint(gl, call, &fill);
 	}
 
 	return;
@@ -1528,6 +2013,8 @@ static void glnvg__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperati
 	if (call == NULL) return;
 
 	call->type = GLNVG_STROKE;
+	call->bounds[0] = call->bounds[1] = 1e6f;
+	call->bounds[2] = call->bounds[3] = -1e6f;
 	call->pathOffset = glnvg__allocPaths(gl, npaths);
 	if (call->pathOffset == -1) goto error;
 	call->pathCount = npaths;
@@ -1550,6 +2037,8 @@ static void glnvg__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperati
 			copy->strokeCount = path->nstroke;
 			memcpy(&gl->verts[offset], path->stroke, sizeof(NVGvertex) * path->nstroke);
 			offset += path->nstroke;
+			if (gl->flags & NVG_MERGE_DRAWS)
+				glnvg__vertBounds(call->bounds, path->stroke, path->nstroke);
 		}
 	}
 
@@ -1581,7 +2070,7 @@ static void glnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 {
 	GLNVGcontext* gl = (GLNVGcontext*)uptr;
 	GLNVGcall* call = glnvg__allocCall(gl);
-	GLNVGfragUniforms* frag;
+	GLNVGfragUniforms frag;
 
 	if (call == NULL) return;
 
@@ -1597,13 +2086,18 @@ static void glnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOper
 	call->triangleCount = nverts;
 
 	memcpy(&gl->verts[call->triangleOffset], verts, sizeof(NVGvertex) * nverts);
+	if (gl->flags & NVG_MERGE_DRAWS) {
+		call->bounds[0] = call->bounds[1] = 1e6f;
+		call->bounds[2] = call->bounds[3] = -1e6f;
+		glnvg__vertBounds(call->bounds, verts, nverts);
+	}
 
 	// Fill shader
 	call->uniformOffset = glnvg__allocFragUniforms(gl, 1);
 	if (call->uniformOffset == -1) goto error;
-	frag = nvg__fragUniformPtr(gl, call->uniformOffset);
-	glnvg__convertPaint(gl, frag, paint, scissor, 1.0f, 1.0f, -1.0f);
-	frag->type = NSVG_SHADER_IMG;
+	glnvg__convertPaint(gl, &frag, paint, scissor, 1.0f, 1.0f, -1.0f);
+	frag.type = NSVG_SHADER_IMG;
+	glnvg__setPaint(gl, call, &frag);
 
 	return;
 
@@ -1621,6 +2115,17 @@ static void glnvg__renderDelete(void* uptr)
 
 	glnvg__deleteShader(&gl->shader);
 
+#if NANOVG_GL_USE_BUFFER_STORAGE
+	if (glnvg__usingRings(gl)) {
+		// verts and uniforms point into the rings, they were never allocated
+		gl->verts = NULL;
+		gl->uniforms = NULL;
+	}
+	while (glnvg__retireFence(gl)) {}
+	glnvg__ringDelete(&gl->vertRing);
+	glnvg__ringDelete(&gl->fragRing);
+#endif
+
 #if NANOVG_GL3
 #if NANOVG_GL_USE_UNIFORMBUFFER
 	if (gl->fragBuf != 0)
@@ -1642,6 +2147,9 @@ static void glnvg__renderDelete(void* uptr)
 	free(gl->verts);
 	free(gl->uniforms);
 	free(gl->calls);
+	free(gl->order);
+	free(gl->firsts);
+	free(gl->counts);
 
 	free(gl);
 }
@@ -1745,4 +2253,20 @@ GLuint nvglImageHandleGLES3(NVGcontext* ctx, int image)
 	return tex->tex;
 }
 
+#if defined NANOVG_GL2
+int nvglDrawCountGL2(NVGcontext* ctx)
+#elif defined NANOVG_GL3
+int nvglDrawCountGL3(NVGcontext* ctx)
+#elif defined NANOVG_GLES2
+int nvglDrawCountGLES2(NVGcontext* ctx)
+#elif defined NANOVG_GLES3
+int nvglDrawCountGLES3(NVGcontext* ctx)
+#endif
+{
+	GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	int count = gl->drawCount;
+	gl->drawCount = 0;
+	return count;
+}
+
 #endif /* NANOVG_GL_IMPLEMENTATION */
@@ -0,0 +1,633 @@
+//
+// Copyright (c) 2009-2013 Mikko Mononen memon@inside.org
+// Copyright (c) 2026 Justin Chambers
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Command queue back-end. This is not part of the original NanoVG distribution,
+// it records the calls NanoVG makes to its render back-end (textures, fills,
+// strokes, triangles, flushes) together with copies of their geometry into a
+// command buffer, and replays them later onto the back-end of another context.
+// Paths are built and tessellated by the recording thread, the target context
+// only submits them, so the two can run on different threads.
+//
+// The queue does no locking of its own. Commands are recorded into one buffer
+// while the previously submitted one is replayed, nvgqueueSubmit() swaps them
+// and must not overlap nvgqueueExecute().
+//
+#ifndef NANOVG_QUEUE_H
+#define NANOVG_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*NVGqueueCallback)(void* data);
+
+// Creates a NanoVG context which records its drawing into a command queue, edgeAntiAlias
+// must match the context the queue is executed on.
+NVGcontext* nvgCreateQueue(int edgeAntiAlias);
+void nvgDeleteQueue(NVGcontext* ctx);
+
+// Records a call to fn on the thread executing the queue, in order with the drawing. The
+// size bytes at data are copied and passed to fn.
+void nvgqueueCall(NVGcontext* ctx, NVGqueueCallback fn, const void* data, int size);
+
+// Sets the function called when the queue needs the commands recorded so far to have been
+// executed before it can return, reading back texture pixels. It must submit the queue and
+// wait for it to be executed.
+void nvgqueueSetSync(NVGcontext* ctx, NVGqueueCallback sync, void* user);
+
+// Makes the recorded commands the ones the next nvgqueueExecute() replays, recording
+// continues into an empty buffer. The previous submission must have been executed.
+void nvgqueueSubmit(NVGcontext* ctx);
+
+// Replays the submitted commands onto the target context's back-end.
+void nvgqueueExecute(NVGcontext* ctx, NVGcontext* target);
+
+// Returns the target context's image for an image of the queue, only valid while executing.
+int nvgqueueTargetImage(NVGcontext* ctx, int image);
+
+// Makes an image created directly on the target context usable on the queue and returns
+// its id there. Only call this while the queue is not being executed and with nothing left
+// to execute, the id can be one whose delete has not reached the target yet otherwise.
+int nvgqueueImportImage(NVGcontext* ctx, int targetImage, int w, int h, int imageFlags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOVG_QUEUE_H */
+
+#ifdef NANOVG_QUEUE_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+#include "nanovg.h"
+
+enum NVGqueueCommandType {
+	NVGQUEUE_CREATE_TEXTURE,
+	NVGQUEUE_DELETE_TEXTURE,
+	NVGQUEUE_UPDATE_TEXTURE,
+	NVGQUEUE_READ_TEXTURE,
+	NVGQUEUE_VIEWPORT,
+	NVGQUEUE_CANCEL,
+	NVGQUEUE_FLUSH,
+	NVGQUEUE_FILL,
+	NVGQUEUE_STROKE,
+	NVGQUEUE_TRIANGLES,
+	NVGQUEUE_CALL
+};
+
+// Every command starts with this header, followed by its payload (texture pixels,
+// paths and vertices, callback data). Sizes are padded to keep payloads aligned.
+struct NVGqueueCommand {
+	int type;
+	int size;
+	int image;
+	int x, y, w, h;
+	int textureType;
+	int imageFlags;
+	int count;
+	float devicePixelRatio;
+	float fringe;
+	float strokeWidth;
+	float bounds[4];
+	NVGpaint paint;
+	NVGcompositeOperationState compositeOperation;
+	NVGscissor scissor;
+	NVGqueueCallback callback;
+	unsigned char* pixels;
+};
+typedef struct NVGqueueCommand NVGqueueCommand;
+
+struct NVGqueueBuffer {
+	unsigned char* data;
+	size_t size;
+	size_t capacity;
+};
+typedef struct NVGqueueBuffer NVGqueueBuffer;
+
+// What the recording side knows about an image, so its size can be answered without
+// waiting on the target
+struct NVGqueueTexture {
+	int width, height;
+	int type;
+	int flags;
+	int nextFree;			// the id deleted before this one, while this one is deleted
+};
+typedef struct NVGqueueTexture NVGqueueTexture;
+
+struct NVGqueueContext {
+	NVGqueueBuffer buffers[2];
+	int recording;			// index of the buffer being recorded, the other one is submitted
+
+	// Recording side images, indexed by image id
+	NVGqueueTexture* textures;
+	int ctextures;
+	int textureId;
+	int freeTexture;		// the last deleted id, reused before a new one, 0 when none
+
+	// Target side image ids, indexed by image id, only touched while executing
+	int* targetImages;
+	int ctargetImages;
+	unsigned char* scratch;	// partial texture updates are rebuilt here at their row offset
+	size_t cscratch;
+
+	NVGqueueCallback sync;
+	void* syncUser;
+};
+typedef struct NVGqueueContext NVGqueueContext;
+
+static size_t nvgqueue__align(size_t size)
+{
+	return (size + 15) & ~(size_t)15;
+}
+
+static NVGqueueContext* nvgqueue__context(NVGcontext* ctx)
+{
+	return (NVGqueueContext*)nvgInternalParams(ctx)->userPtr;
+}
+
+// Appends a command with room for payload bytes after it, returns NULL when out of memory.
+// The pointer is only valid until the next command is allocated.
+static NVGqueueCommand* nvgqueue__alloc(NVGqueueContext* q, int type, size_t payload)
+{
+	NVGqueueBuffer* buffer = &q->buffers[q->recording];
+	size_t size = nvgqueue__align(sizeof(NVGqueueCommand)) + nvgqueue__align(payload);
+	NVGqueueCommand* cmd;
+
+	if (size > 0x7fffffff) return NULL;
+	if (buffer->size + size > buffer->capacity) {
+		size_t capacity = buffer->capacity < 65536 ? 65536 : buffer->capacity;
+		unsigned char* data;
+		while (capacity < buffer->size + size)
+			capacity *= 2;
+		data = (unsigned char*)realloc(buffer->data, capacity);
+		if (data == NULL) return NULL;
+		buffer->data = data;
+		buffer->capacity = capacity;
+	}
+
+	cmd = (NVGqueueCommand*)&buffer->data[buffer->size];
+	memset(cmd, 0, sizeof(NVGqueueCommand));
+	cmd->type = type;
+	cmd->size = (int)size;
+	buffer->size += size;
+	return cmd;
+}
+
+static unsigned char* nvgqueue__payload(NVGqueueCommand* cmd)
+{
+	return (unsigned char*)cmd + nvgqueue__align(sizeof(NVGqueueCommand));
+}
+
+static NVGqueueTexture* nvgqueue__findTexture(NVGqueueContext* q, int image)
+{
+	if (image <= 0 || image >= q->ctextures || q->textures[image].type == 0) return NULL;
+	return &q->textures[image];
+}
+
+// Deleted ids are reused, which keeps both sides' tables as large as the most images alive at
+// once. A reused id reaches the target after the delete of its previous image, in order.
+static int nvgqueue__addTexture(NVGqueueContext* q, int type, int w, int h, int imageFlags)
+{
+	int id = q->freeTexture;
+	if (id != 0) {
+		q->freeTexture = q->textures[id].nextFree;
+	} else {
+		id = q->textureId + 1;
+		if (id >= q->ctextures) {
+			int ctextures = q->ctextures < 64 ? 64 : q->ctextures * 2;
+			NVGqueueTexture* textures = (NVGqueueTexture*)realloc(q->textures, sizeof(NVGqueueTexture) * ctextures);
+			if (textures == NULL) return 0;
+			memset(&textures[q->ctextures], 0, sizeof(NVGqueueTexture) * (ctextures - q->ctextures));
+			q->textures = textures;
+			q->ctextures = ctextures;
+		}
+		q->textureId = id;
+	}
+	q->textures[id].nextFree = 0;
+	q->textures[id].width = w;
+	q->textures[id].height = h;
+	q->textures[id].type = type;
+	q->textures[id].flags = imageFlags;
+	return id;
+}
+
+static void nvgqueue__freeTexture(NVGqueueContext* q, int id)
+{
+	q->textures[id].type = 0;
+	q->textures[id].nextFree = q->freeTexture;
+	q->freeTexture = id;
+}
+
+static int nvgqueue__setTargetImage(NVGqueueContext* q, int image, int targetImage)
+{
+	if (image >= q->ctargetImages) {
+		int ctargetImages = q->ctargetImages < 64 ? 64 : q->ctargetImages;
+		int* targetImages;
+		while (ctargetImages <= image)
+			ctargetImages *= 2;
+		targetImages = (int*)realloc(q->targetImages, sizeof(int) * ctargetImages);
+		if (targetImages == NULL) return 0;
+		memset(&targetImages[q->ctargetImages], 0, sizeof(int) * (ctargetImages - q->ctargetImages));
+		q->targetImages = targetImages;
+		q->ctargetImages = ctargetImages;
+	}
+	q->targetImages[image] = targetImage;
+	return 1;
+}
+
+static int nvgqueue__renderCreate(void* uptr)
+{
+	NVG_NOTUSED(uptr);
+	return 1;
+}
+
+static int nvgqueue__renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	size_t size = data != NULL ? (size_t)w * (size_t)h * (type == NVG_TEXTURE_RGBA ? 4 : 1) : 0;
+	NVGqueueCommand* cmd;
+	int id = nvgqueue__addTexture(q, type, w, h, imageFlags);
+	if (id == 0) return 0;
+
+	cmd = nvgqueue__alloc(q, NVGQUEUE_CREATE_TEXTURE, size);
+	if (cmd == NULL) {
+		nvgqueue__freeTexture(q, id);
+		return 0;
+	}
+	cmd->image = id;
+	cmd->textureType = type;
+	cmd->w = w;
+	cmd->h = h;
+	cmd->imageFlags = imageFlags;
+	cmd->count = data != NULL;
+	if (data != NULL)
+		memcpy(nvgqueue__payload(cmd), data, size);
+	return id;
+}
+
+static int nvgqueue__renderDeleteTexture(void* uptr, int image)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	NVGqueueTexture* tex = nvgqueue__findTexture(q, image);
+	NVGqueueCommand* cmd;
+	if (tex == NULL) return 0;
+
+	// the id is only reused once the delete is recorded ahead of its next create
+	cmd = nvgqueue__alloc(q, NVGQUEUE_DELETE_TEXTURE, 0);
+	if (cmd == NULL) return 0;
+	cmd->image = image;
+	nvgqueue__freeTexture(q, image);
+	return 1;
+}
+
+static int nvgqueue__renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	NVGqueueTexture* tex = nvgqueue__findTexture(q, image);
+	NVGqueueCommand* cmd;
+	size_t stride;
+	if (tex == NULL) return 0;
+
+	// data holds the whole image, only the updated rows are copied
+	stride = (size_t)tex->width * (tex->type == NVG_TEXTURE_RGBA ? 4 : 1);
+	cmd = nvgqueue__alloc(q, NVGQUEUE_UPDATE_TEXTURE, stride * (size_t)h);
+	if (cmd == NULL) return 0;
+	cmd->image = image;
+	cmd->x = x;
+	cmd->y = y;
+	cmd->w = w;
+	cmd->h = h;
+	cmd->count = (int)stride;
+	memcpy(nvgqueue__payload(cmd), data + stride * (size_t)y, stride * (size_t)h);
+	return 1;
+}
+
+static int nvgqueue__renderGetTexturePixelData(void* uptr, int image, unsigned char* data)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	NVGqueueCommand* cmd;
+	if (nvgqueue__findTexture(q, image) == NULL || q->sync == NULL) return 0;
+
+	cmd = nvgqueue__alloc(q, NVGQUEUE_READ_TEXTURE, 0);
+	if (cmd == NULL) return 0;
+	cmd->image = image;
+	cmd->pixels = data;
+
+	// the pixels are only there once the target has caught up
+	q->sync(q->syncUser);
+	return 1;
+}
+
+static int nvgqueue__renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	NVGqueueTexture* tex = nvgqueue__findTexture(q, image);
+	if (tex == NULL) return 0;
+	*w = tex->width;
+	*h = tex->height;
+	return 1;
+}
+
+static void nvgqueue__renderViewport(void* uptr, int width, int height, float devicePixelRatio)
+{
+	NVGqueueCommand* cmd = nvgqueue__alloc((NVGqueueContext*)uptr, NVGQUEUE_VIEWPORT, 0);
+	if (cmd == NULL) return;
+	cmd->w = width;
+	cmd->h = height;
+	cmd->devicePixelRatio = devicePixelRatio;
+}
+
+static void nvgqueue__renderCancel(void* uptr)
+{
+	nvgqueue__alloc((NVGqueueContext*)uptr, NVGQUEUE_CANCEL, 0);
+}
+
+static void nvgqueue__renderFlush(void* uptr)
+{
+	nvgqueue__alloc((NVGqueueContext*)uptr, NVGQUEUE_FLUSH, 0);
+}
+
+// Copies paths and their fill and stroke vertices after the command. The payload is the
+// paths, then per path the offsets of its fill and stroke vertices, then the vertices.
+static NVGqueueCommand* nvgqueue__allocPaths(NVGqueueContext* q, int type, const NVGpath* paths, int npaths)
+{
+	size_t pathBytes = nvgqueue__align(sizeof(NVGpath) * (size_t)npaths);
+	size_t offsetBytes = nvgqueue__align(sizeof(int) * 2 * (size_t)npaths);
+	size_t nverts = 0;
+	NVGqueueCommand* cmd;
+	NVGpath* dstPaths;
+	NVGvertex* verts;
+	int* offsets;
+	int i;
+
+	for (i = 0; i < npaths; i++)
+		nverts += (size_t)paths[i].nfill + (size_t)paths[i].nstroke;
+
+	cmd = nvgqueue__alloc(q, type, pathBytes + offsetBytes + sizeof(NVGvertex) * nverts);
+	if (cmd == NULL) return NULL;
+	cmd->count = npaths;
+
+	dstPaths = (NVGpath*)nvgqueue__payload(cmd);
+	offsets = (int*)(nvgqueue__payload(cmd) + pathBytes);
+	verts = (NVGvertex*)(nvgqueue__payload(cmd) + pathBytes + offsetBytes);
+	memcpy(dstPaths, paths, sizeof(NVGpath) * (size_t)npaths);
+
+	nverts = 0;
+	for (i = 0; i < npaths; i++) {
+		offsets[i * 2] = (int)nverts;
+		if (paths[i].nfill > 0)
+			memcpy(&verts[nverts], paths[i].fill, sizeof(NVGvertex) * (size_t)paths[i].nfill);
+		nverts += (size_t)paths[i].nfill;
+
+		offsets[i * 2 + 1] = (int)nverts;
+		if (paths[i].nstroke > 0)
+			memcpy(&verts[nverts], paths[i].stroke, sizeof(NVGvertex) * (size_t)paths[i].nstroke);
+		nverts += (size_t)paths[i].nstroke;
+
+		dstPaths[i].fill = NULL;
+		dstPaths[i].stroke = NULL;
+	}
+	return cmd;
+}
+
+// Points the copied paths at their copied vertices
+static NVGpath* nvgqueue__fixPaths(NVGqueueCommand* cmd)
+{
+	size_t pathBytes = nvgqueue__align(sizeof(NVGpath) * (size_t)cmd->count);
+	size_t offsetBytes = nvgqueue__align(sizeof(int) * 2 * (size_t)cmd->count);
+	NVGpath* paths = (NVGpath*)nvgqueue__payload(cmd);
+	int* offsets = (int*)(nvgqueue__payload(cmd) + pathBytes);
+	NVGvertex* verts = (NVGvertex*)(nvgqueue__payload(cmd) + pathBytes + offsetBytes);
+	int i;
+	for (i = 0; i < cmd->count; i++) {
+		paths[i].fill = paths[i].nfill > 0 ? &verts[offsets[i * 2]] : NULL;
+		paths[i].stroke = paths[i].nstroke > 0 ? &verts[offsets[i * 2 + 1]] : NULL;
+	}
+	return paths;
+}
+
+static void nvgqueue__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+								 const float* bounds, const NVGpath* paths, int npaths)
+{
+	NVGqueueCommand* cmd = nvgqueue__allocPaths((NVGqueueContext*)uptr, NVGQUEUE_FILL, paths, npaths);
+	if (cmd == NULL) return;
+	cmd->paint = *paint;
+	cmd->compositeOperation = compositeOperation;
+	cmd->scissor = *scissor;
+	cmd->fringe = fringe;
+	memcpy(cmd->bounds, bounds, sizeof(cmd->bounds));
+}
+
+static void nvgqueue__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+								   float strokeWidth, const NVGpath* paths, int npaths)
+{
+	NVGqueueCommand* cmd = nvgqueue__allocPaths((NVGqueueContext*)uptr, NVGQUEUE_STROKE, paths, npaths);
+	if (cmd == NULL) return;
+	cmd->paint = *paint;
+	cmd->compositeOperation = compositeOperation;
+	cmd->scissor = *scissor;
+	cmd->fringe = fringe;
+	cmd->strokeWidth = strokeWidth;
+}
+
+static void nvgqueue__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+									  const NVGvertex* verts, int nverts)
+{
+	NVGqueueCommand* cmd = nvgqueue__alloc((NVGqueueContext*)uptr, NVGQUEUE_TRIANGLES, sizeof(NVGvertex) * (size_t)nverts);
+	if (cmd == NULL) return;
+	cmd->paint = *paint;
+	cmd->compositeOperation = compositeOperation;
+	cmd->scissor = *scissor;
+	cmd->count = nverts;
+	memcpy(nvgqueue__payload(cmd), verts, sizeof(NVGvertex) * (size_t)nverts);
+}
+
+static void nvgqueue__renderDelete(void* uptr)
+{
+	NVGqueueContext* q = (NVGqueueContext*)uptr;
+	if (q == NULL) return;
+	free(q->buffers[0].data);
+	free(q->buffers[1].data);
+	free(q->textures);
+	free(q->targetImages);
+	free(q->scratch);
+	free(q);
+}
+
+NVGcontext* nvgCreateQueue(int edgeAntiAlias)
+{
+	NVGparams params;
+	NVGcontext* ctx = NULL;
+	NVGqueueContext* q = (NVGqueueContext*)malloc(sizeof(NVGqueueContext));
+	if (q == NULL) goto error;
+	memset(q, 0, sizeof(NVGqueueContext));
+
+	memset(&params, 0, sizeof(params));
+	params.renderCreate = nvgqueue__renderCreate;
+	params.renderCreateTexture = nvgqueue__renderCreateTexture;
+	params.renderDeleteTexture = nvgqueue__renderDeleteTexture;
+	params.renderUpdateTexture = nvgqueue__renderUpdateTexture;
+	params.renderGetTexturePixelData = nvgqueue__renderGetTexturePixelData;
+	params.renderGetTextureSize = nvgqueue__renderGetTextureSize;
+	params.renderViewport = nvgqueue__renderViewport;
+	params.renderCancel = nvgqueue__renderCancel;
+	params.renderFlush = nvgqueue__renderFlush;
+	params.renderFill = nvgqueue__renderFill;
+	params.renderStroke = nvgqueue__renderStroke;
+	params.renderTriangles = nvgqueue__renderTriangles;
+	params.renderDelete = nvgqueue__renderDelete;
+	params.userPtr = q;
+	params.edgeAntiAlias = edgeAntiAlias;
+
+	ctx = nvgCreateInternal(&params);
+	if (ctx == NULL) goto error;
+
+	return ctx;
+
+error:
+	// 'q' is freed by nvgDeleteInternal.
+	if (ctx != NULL) nvgDeleteInternal(ctx);
+	return NULL;
+}
+
+void nvgDeleteQueue(NVGcontext* ctx)
+{
+	nvgDeleteInternal(ctx);
+}
+
+void nvgqueueCall(NVGcontext* ctx, NVGqueueCallback fn, const void* data, int size)
+{
+	NVGqueueCommand* cmd = nvgqueue__alloc(nvgqueue__context(ctx), NVGQUEUE_CALL, (size_t)(size > 0 ? size : 0));
+	if (cmd == NULL) return;
+	cmd->callback = fn;
+	cmd->count = size;
+	if (size > 0)
+		memcpy(nvgqueue__payload(cmd), data, (size_t)size);
+}
+
+void nvgqueueSetSync(NVGcontext* ctx, NVGqueueCallback sync, void* user)
+{
+	NVGqueueContext* q = nvgqueue__context(ctx);
+	q->sync = sync;
+	q->syncUser = user;
+}
+
+void nvgqueueSubmit(NVGcontext* ctx)
+{
+	NVGqueueContext* q = nvgqueue__context(ctx);
+	q->recording ^= 1;
+	q->buffers[q->recording].size = 0;
+}
+
+void nvgqueueExecute(NVGcontext* ctx, NVGcontext* target)
+{
+	NVGqueueContext* q = nvgqueue__context(ctx);
+	NVGqueueBuffer* buffer = &q->buffers[q->recording ^ 1];
+	NVGparams* params = nvgInternalParams(target);
+	void* uptr = params->userPtr;
+	size_t offset = 0;
+
+	while (offset < buffer->size) {
+		NVGqueueCommand* cmd = (NVGqueueCommand*)&buffer->data[offset];
+		unsigned char* payload = nvgqueue__payload(cmd);
+		offset += (size_t)cmd->size;
+
+		// images are referred to by their queue ids until they reach the target
+		if (cmd->type != NVGQUEUE_CREATE_TEXTURE)
+			cmd->image = nvgqueueTargetImage(ctx, cmd->image);
+		cmd->paint.image = nvgqueueTargetImage(ctx, cmd->paint.image);
+
+		switch (cmd->type) {
+		case NVGQUEUE_CREATE_TEXTURE:
+			nvgqueue__setTargetImage(q, cmd->image,
+				params->renderCreateTexture(uptr, cmd->textureType, cmd->w, cmd->h, cmd->imageFlags, cmd->count ? payload : NULL));
+			break;
+		case NVGQUEUE_DELETE_TEXTURE:
+			params->renderDeleteTexture(uptr, cmd->image);
+			break;
+		case NVGQUEUE_UPDATE_TEXTURE: {
+			// back-ends read updates from a buffer the size of the image, the rows above the
+			// update are never read and are left uninitialized
+			size_t stride = (size_t)cmd->count;
+			unsigned char* data = payload;
+			if (cmd->y > 0) {
+				size_t size = stride * (size_t)(cmd->y + cmd->h);
+				if (size > q->cscratch) {
+					unsigned char* scratch = (unsigned char*)realloc(q->scratch, size);
+					if (scratch == NULL) break;
+					q->scratch = scratch;
+					q->cscratch = size;
+				}
+				data = q->scratch;
+				memcpy(data + stride * (size_t)cmd->y, payload, stride * (size_t)cmd->h);
+			}
+			params->renderUpdateTexture(uptr, cmd->image, cmd->x, cmd->y, cmd->w, cmd->h, data);
+			break;
+		}
+		case NVGQUEUE_READ_TEXTURE:
+			params->renderGetTexturePixelData(uptr, cmd->image, cmd->pixels);
+			break;
+		case NVGQUEUE_VIEWPORT:
+			params->renderViewport(uptr, cmd->w, cmd->h, cmd->devicePixelRatio);
+			break;
+		case NVGQUEUE_CANCEL:
+			params->renderCancel(uptr);
+			break;
+		case NVGQUEUE_FLUSH:
+			params->renderFlush(uptr);
+			break;
+		case NVGQUEUE_FILL:
+			params->renderFill(uptr, &cmd->paint, cmd->compositeOperation, &cmd->scissor, cmd->fringe, cmd->bounds,
+				nvgqueue__fixPaths(cmd), cmd->count);
+			break;
+		case NVGQUEUE_STROKE:
+			params->renderStroke(uptr, &cmd->paint, cmd->compositeOperation, &cmd->scissor, cmd->fringe, cmd->strokeWidth,
+				nvgqueue__fixPaths(cmd), cmd->count);
+			break;
+		case NVGQUEUE_TRIANGLES:
+			params->renderTriangles(uptr, &cmd->paint, cmd->compositeOperation, &cmd->scissor, (const NVGvertex*)payload, cmd->count);
+			break;
+		case NVGQUEUE_CALL:
+			cmd->callback(payload);
+			break;
+		}
+	}
+	buffer->size = 0;
+}
+
+int nvgqueueTargetImage(NVGcontext* ctx, int image)
+{
+	NVGqueueContext* q = nvgqueue__context(ctx);
+	if (image <= 0 || image >= q->ctargetImages) return 0;
+	return q->targetImages[image];
+}
+
+int nvgqueueImportImage(NVGcontext* ctx, int targetImage, int w, int h, int imageFlags)
+{
+	NVGqueueContext* q = nvgqueue__context(ctx);
+	int id = nvgqueue__addTexture(q, NVG_TEXTURE_RGBA, w, h, imageFlags);
+	if (id == 0) return 0;
+	if (!nvgqueue__setTargetImage(q, id, targetImage)) {
+		nvgqueue__freeTexture(q, id);
+		return 0;
+	}
+	return id;
+}
+
+#endif /* NANOVG_QUEUE_IMPLEMENTATION */
@@ -0,0 +1,1725 @@
+//
+// Copyright (c) 2009-2013 Mikko Mononen memon@inside.org
+// Copyright (c) 2026 Justin Chambers
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// Software (CPU) render back-end. This is not part of the original NanoVG
+// distribution, it mirrors nanovg_gl.h call for call (stencil fills, stencil
+// strokes, edge anti-aliasing, paints and blend equations) but rasterizes into
+// an RGBA8 framebuffer in system memory so no GPU or GL context is required.
+//
+#ifndef NANOVG_SW_H
+#define NANOVG_SW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Create flags
+
+enum NVGswCreateFlags {
+	// Flag indicating if geometry based anti-aliasing is used.
+	NVGSW_ANTIALIAS 		= 1<<0,
+	// Flag indicating if strokes should be drawn using the stencil buffer so path overlaps
+	// (i.e. self-intersecting or sharp turns) will be drawn just once.
+	NVGSW_STENCIL_STROKES	= 1<<1,
+};
+
+// Creates a NanoVG context which renders into a width x height RGBA8 framebuffer.
+NVGcontext* nvgCreateSW(int flags, int width, int height);
+void nvgDeleteSW(NVGcontext* ctx);
+
+// Resizes the framebuffer, the contents are cleared to transparent black.
+int nvgswResizeFramebuffer(NVGcontext* ctx, int width, int height);
+
+// Returns the framebuffer pixels (RGBA8, rows ordered top to bottom) and its size.
+unsigned char* nvgswFramebuffer(NVGcontext* ctx, int* width, int* height);
+
+// Clears the render target to a color, the equivalent of glClear on the GL back-end.
+void nvgswClear(NVGcontext* ctx, NVGcolor color);
+
+// Makes an RGBA image the render target, the equivalent of binding a framebuffer object
+// on the GL back-end, 0 binds the framebuffer again. Queued draw calls render into the
+// target bound when they are flushed, so call nvgFlush() before switching.
+// Returns 0 if the image is not an RGBA image.
+int nvgswBindTarget(NVGcontext* ctx, int image);
+
+// Sets how many threads rasterize the framebuffer tiles, including the calling thread.
+// Contexts start with one thread per processor, 0 restores that default.
+void nvgswSetThreadCount(NVGcontext* ctx, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOVG_SW_H */
+
+#ifdef NANOVG_SW_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "nanovg.h"
+#include "tinycthread.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWNVG_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The framebuffer is split into square tiles, each tile is rasterized by one thread
+// at a time and runs the frame's draw calls in submission order.
+#define SWNVG_TILE_SIZE 64
+#define SWNVG_MAX_THREADS 64
+
+// Triangle lists are split into calls of nearby triangles, at most this many vertices each,
+// so large batches are only binned into the tiles each piece touches.
+#define SWNVG_TRIANGLE_CHUNK 384
+
+// Vertices are snapped to 1/256th of a pixel so edge functions are exact and
+// triangles sharing an edge never both touch (or both miss) a pixel.
+#define SWNVG_SUBPIXEL_BITS 8
+#define SWNVG_SUBPIXEL_ONE (1 << SWNVG_SUBPIXEL_BITS)
+#define SWNVG_MAX_COORD 4000000.0f
+
+enum SWNVGshaderType {
+	SWNVG_SHADER_FILLGRAD,
+	SWNVG_SHADER_FILLIMG,
+	SWNVG_SHADER_SIMPLE,
+	SWNVG_SHADER_IMG
+};
+
+enum SWNVGcallType {
+	SWNVG_NONE = 0,
+	SWNVG_FILL,
+	SWNVG_CONVEXFILL,
+	SWNVG_STROKE,
+	SWNVG_TRIANGLES,
+};
+
+enum SWNVGprimitive {
+	SWNVG_PRIM_TRIANGLES,
+	SWNVG_PRIM_STRIP,
+	SWNVG_PRIM_FAN
+};
+
+enum SWNVGstencilFunc {
+	SWNVG_STENCIL_ALWAYS,
+	SWNVG_STENCIL_EQUAL,		// passes when the stencil is zero
+	SWNVG_STENCIL_NOTEQUAL		// passes when the stencil is not zero
+};
+
+enum SWNVGstencilOp {
+	SWNVG_STENCIL_KEEP,
+	SWNVG_STENCIL_INCR,
+	SWNVG_STENCIL_ZERO,
+	SWNVG_STENCIL_WINDING		// increment on front faces, decrement on back faces (wrapping)
+};
+
+struct SWNVGtexture {
+	int id;
+	unsigned char* data;
+	int width, height;
+	int type;
+	int flags;
+};
+typedef struct SWNVGtexture SWNVGtexture;
+
+struct SWNVGcall {
+	int type;
+	int image;
+	int pathOffset;
+	int pathCount;
+	int triangleOffset;
+	int triangleCount;
+	int vertOffset;
+	int vertCount;
+	int uniformOffset;
+	int textureFilterMode;
+	int textureWrapMode;
+	NVGcompositeOperationState blendFunc;
+};
+typedef struct SWNVGcall SWNVGcall;
+
+struct SWNVGpath {
+	int fillOffset;
+	int fillCount;
+	int strokeOffset;
+	int strokeCount;
+};
+typedef struct SWNVGpath SWNVGpath;
+
+struct SWNVGfragUniforms {
+	float scissorMat[6];
+	float paintMat[6];
+	NVGcolor innerCol;
+	NVGcolor outerCol;
+	float scissorExt[2];
+	float scissorScale[2];
+	float extent[2];
+	float radius;
+	float feather;
+	float strokeMult;
+	float strokeThr;
+	int texType;
+	int type;
+	int solid;		// inner and outer colors match, the gradient can be skipped
+	int scissor;	// scissor is active
+};
+typedef struct SWNVGfragUniforms SWNVGfragUniforms;
+
+struct SWNVGrect {
+	int x0, y0, x1, y1;	// x1 and y1 are exclusive
+};
+typedef struct SWNVGrect SWNVGrect;
+
+// Pipeline state for one draw, the equivalent of what the GL back-end sets up before glDrawArrays.
+struct SWNVGpass {
+	const SWNVGfragUniforms* frag;
+	const SWNVGtexture* tex;
+	int textureFilterMode;
+	int textureWrapMode;
+	NVGcompositeOperationState blendFunc;
+	int cull;
+	int stencilFunc;
+	int stencilOp;
+	int writeColor;
+};
+typedef struct SWNVGpass SWNVGpass;
+
+struct SWNVGcontext {
+	SWNVGtexture* textures;
+	float view[2];
+	int ntextures;
+	int ctextures;
+	int textureId;
+	int flags;
+
+	// Render target, either the framebuffer or the image bound with nvgswBindTarget
+	unsigned char* pixels;
+	unsigned char* stencil;
+	int width;
+	int height;
+	float scale[2];
+	int target;
+
+	// The framebuffer while an image is the render target
+	unsigned char* fbPixels;
+	unsigned char* fbStencil;
+	int fbWidth;
+	int fbHeight;
+
+	// Stencil buffer shared by image render targets
+	unsigned char* targetStencil;
+	size_t ctargetStencil;
+
+	// Per frame buffers
+	SWNVGcall* calls;
+	int ccalls;
+	int ncalls;
+	SWNVGpath* paths;
+	int cpaths;
+	int npaths;
+	struct NVGvertex* verts;
+	int cverts;
+	int nverts;
+	SWNVGfragUniforms* uniforms;
+	int cuniforms;
+	int nuniforms;
+
+	// Tile bins, the calls touching tile i are tileCalls[tileBins[i]] to tileCalls[tileBins[i+1]-1]
+	SWNVGrect* callBounds;
+	int ccallBounds;
+	int* tileBins;
+	int ctileBins;
+	int* tileCalls;
+	int ctileCalls;
+	int tilesX;
+	int tilesY;
+
+	// Worker pool
+	thrd_t threads[SWNVG_MAX_THREADS];
+	int nthreads;
+	mtx_t lock;
+	cnd_t wake;
+	cnd_t done;
+	int generation;
+	int ntiles;
+	int nextTile;
+	int tilesDone;
+	int quit;
+};
+typedef struct SWNVGcontext SWNVGcontext;
+
+static int swnvg__maxi(int a, int b) { return a > b ? a : b; }
+static int swnvg__mini(int a, int b) { return a < b ? a : b; }
+static float swnvg__minf(float a, float b) { return a < b ? a : b; }
+static float swnvg__maxf(float a, float b) { return a > b ? a : b; }
+static float swnvg__clampf(float a, float mn, float mx) { return a < mn ? mn : (a > mx ? mx : a); }
+
+static SWNVGtexture* swnvg__allocTexture(SWNVGcontext* sw)
+{
+	SWNVGtexture* tex = NULL;
+	int i;
+
+	for (i = 0; i < sw->ntextures; i++) {
+		if (sw->textures[i].id == 0) {
+			tex = &sw->textures[i];
+			break;
+		}
+	}
+	if (tex == NULL) {
+		if (sw->ntextures+1 > sw->ctextures) {
+			SWNVGtexture* textures;
+			int ctextures = swnvg__maxi(sw->ntextures+1, 4) +  sw->ctextures/2; // 1.5x Overallocate
+			textures = (SWNVGtexture*)realloc(sw->textures, sizeof(SWNVGtexture)*ctextures);
+			if (textures == NULL) return NULL;
+			sw->textures = textures;
+			sw->ctextures = ctextures;
+		}
+		tex = &sw->textures[sw->ntextures++];
+	}
+
+	memset(tex, 0, sizeof(*tex));
+	tex->id = ++sw->textureId;
+
+	return tex;
+}
+
+static SWNVGtexture* swnvg__findTexture(SWNVGcontext* sw, int id)
+{
+	int i;
+	for (i = 0; i < sw->ntextures; i++)
+		if (sw->textures[i].id == id)
+			return &sw->textures[i];
+	return NULL;
+}
+
+static int swnvg__bindTarget(SWNVGcontext* sw, SWNVGtexture* tex)
+{
+	size_t count;
+
+	if (sw->target != 0) {
+		sw->pixels = sw->fbPixels;
+		sw->stencil = sw->fbStencil;
+		sw->width = sw->fbWidth;
+		sw->height = sw->fbHeight;
+		sw->target = 0;
+	}
+	if (tex == NULL) return 1;
+	if (tex->type != NVG_TEXTURE_RGBA) return 0;
+
+	count = (size_t)tex->width * (size_t)tex->height;
+	if (count > sw->ctargetStencil) {
+		unsigned char* stencil = (unsigned char*)realloc(sw->targetStencil, count);
+		if (stencil == NULL) return 0;
+		sw->targetStencil = stencil;
+		sw->ctargetStencil = count;
+	}
+	memset(sw->targetStencil, 0, count);
+
+	sw->fbPixels = sw->pixels;
+	sw->fbStencil = sw->stencil;
+	sw->fbWidth = sw->width;
+	sw->fbHeight = sw->height;
+	sw->pixels = tex->data;
+	sw->stencil = sw->targetStencil;
+	sw->width = tex->width;
+	sw->height = tex->height;
+	sw->target = tex->id;
+	return 1;
+}
+
+static int swnvg__deleteTexture(SWNVGcontext* sw, int id)
+{
+	int i;
+	for (i = 0; i < sw->ntextures; i++) {
+		if (sw->textures[i].id == id) {
+			if (sw->target == id)
+				swnvg__bindTarget(sw, NULL);
+			free(sw->textures[i].data);
+			memset(&sw->textures[i], 0, sizeof(sw->textures[i]));
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int swnvg__renderCreate(void* uptr)
+{
+	NVG_NOTUSED(uptr);
+	return 1;
+}
+
+static int swnvg__renderCreateTexture(void* uptr, int type, int w, int h, int imageFlags, const unsigned char* data)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__allocTexture(sw);
+	size_t size = (size_t)w * (size_t)h * (type == NVG_TEXTURE_RGBA ? 4 : 1);
+
+	if (tex == NULL) return 0;
+
+	tex->data = (unsigned char*)malloc(size);
+	if (tex->data == NULL) {
+		tex->id = 0;
+		return 0;
+	}
+	if (data != NULL)
+		memcpy(tex->data, data, size);
+	else
+		memset(tex->data, 0, size);
+
+	tex->width = w;
+	tex->height = h;
+	tex->type = type;
+	tex->flags = imageFlags;
+
+	return tex->id;
+}
+
+static int swnvg__renderDeleteTexture(void* uptr, int image)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	return swnvg__deleteTexture(sw, image);
+}
+
+static int swnvg__renderUpdateTexture(void* uptr, int image, int x, int y, int w, int h, const unsigned char* data)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	int bpp, row;
+
+	if (tex == NULL || data == NULL) return 0;
+
+	// Same convention as GL_UNPACK_ROW_LENGTH/SKIP_PIXELS/SKIP_ROWS: data holds the whole image
+	bpp = tex->type == NVG_TEXTURE_RGBA ? 4 : 1;
+	for (row = y; row < y + h; row++) {
+		size_t offset = ((size_t)row * tex->width + x) * bpp;
+		memcpy(&tex->data[offset], &data[offset], (size_t)w * bpp);
+	}
+
+	return 1;
+}
+
+static int swnvg__renderGetTexturePixelData(void* uptr, int image, unsigned char* data)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	int i, count;
+
+	if (tex == NULL) return 0;
+
+	count = tex->width * tex->height;
+	if (tex->type == NVG_TEXTURE_RGBA) {
+		memcpy(data, tex->data, (size_t)count * 4);
+	} else {
+		// Matches glGetTexImage(GL_RGBA) on a GL_RED texture
+		for (i = 0; i < count; i++) {
+			data[i*4+0] = tex->data[i];
+			data[i*4+1] = 0;
+			data[i*4+2] = 0;
+			data[i*4+3] = 255;
+		}
+	}
+
+	return 1;
+}
+
+static int swnvg__renderGetTextureSize(void* uptr, int image, int* w, int* h)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGtexture* tex = swnvg__findTexture(sw, image);
+	if (tex == NULL) return 0;
+	*w = tex->width;
+	*h = tex->height;
+	return 1;
+}
+
+static NVGcolor swnvg__premulColor(NVGcolor c)
+{
+	c.r *= c.a;
+	c.g *= c.a;
+	c.b *= c.a;
+	return c;
+}
+
+static int swnvg__convertPaint(SWNVGcontext* sw, SWNVGfragUniforms* frag, NVGpaint* paint,
+							   NVGscissor* scissor, float width, float fringe, float strokeThr)
+{
+	SWNVGtexture* tex = NULL;
+
+	memset(frag, 0, sizeof(*frag));
+
+	frag->innerCol = swnvg__premulColor(paint->innerColor);
+	frag->outerCol = swnvg__premulColor(paint->outerColor);
+	frag->solid = memcmp(&frag->innerCol, &frag->outerCol, sizeof(NVGcolor)) == 0;
+
+	if (scissor->extent[0] < -0.5f || scissor->extent[1] < -0.5f) {
+		frag->scissor = 0;
+		frag->scissorExt[0] = 1.0f;
+		frag->scissorExt[1] = 1.0f;
+		frag->scissorScale[0] = 1.0f;
+		frag->scissorScale[1] = 1.0f;
+	} else {
+		frag->scissor = 1;
+		nvgTransformInverse(frag->scissorMat, scissor->xform);
+		frag->scissorExt[0] = scissor->extent[0];
+		frag->scissorExt[1] = scissor->extent[1];
+		frag->scissorScale[0] = sqrtf(scissor->xform[0]*scissor->xform[0] + scissor->xform[2]*scissor->xform[2]) / fringe;
+		frag->scissorScale[1] = sqrtf(scissor->xform[1]*scissor->xform[1] + scissor->xform[3]*scissor->xform[3]) / fringe;
+	}
+
+	memcpy(frag->extent, paint->extent, sizeof(frag->extent));
+	frag->strokeMult = (width*0.5f + fringe*0.5f) / fringe;
+	frag->strokeThr = strokeThr;
+
+	if (paint->image != 0) {
+		tex = swnvg__findTexture(sw, paint->image);
+		if (tex == NULL) return 0;
+		if ((tex->flags & NVG_IMAGE_FLIPY) != 0) {
+			float m1[6], m2[6];
+			nvgTransformTranslate(m1, 0.0f, frag->extent[1] * 0.5f);
+			nvgTransformMultiply(m1, paint->xform);
+			nvgTransformScale(m2, 1.0f, -1.0f);
+			nvgTransformMultiply(m2, m1);
+			nvgTransformTranslate(m1, 0.0f, -frag->extent[1] * 0.5f);
+			nvgTransformMultiply(m1, m2);
+			nvgTransformInverse(frag->paintMat, m1);
+		} else {
+			nvgTransformInverse(frag->paintMat, paint->xform);
+		}
+		frag->type = SWNVG_SHADER_FILLIMG;
+
+		if (tex->type == NVG_TEXTURE_RGBA)
+			frag->texType = (tex->flags & NVG_IMAGE_PREMULTIPLIED) ? 0 : 1;
+		else
+			frag->texType = 2;
+	} else {
+		frag->type = SWNVG_SHADER_FILLGRAD;
+		frag->radius = paint->radius;
+		frag->feather = paint->feather;
+		nvgTransformInverse(frag->paintMat, paint->xform);
+	}
+
+	return 1;
+}
+
+static void swnvg__renderViewport(void* uptr, int width, int height, float devicePixelRatio)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	NVG_NOTUSED(devicePixelRatio);
+	sw->view[0] = (float)width;
+	sw->view[1] = (float)height;
+}
+
+//
+// Fragment stage, the C equivalent of the fill fragment shader in nanovg_gl.h
+//
+
+static float swnvg__sdroundrect(float px, float py, float ex, float ey, float rad)
+{
+	float dx = fabsf(px) - (ex - rad);
+	float dy = fabsf(py) - (ey - rad);
+	float mx = swnvg__maxf(dx, 0.0f);
+	float my = swnvg__maxf(dy, 0.0f);
+	return swnvg__minf(swnvg__maxf(dx, dy), 0.0f) + sqrtf(mx*mx + my*my) - rad;
+}
+
+static float swnvg__scissorMask(const SWNVGfragUniforms* frag, float x, float y)
+{
+	const float* m = frag->scissorMat;
+	float scx, scy;
+	if (!frag->scissor) return 1.0f;
+	scx = fabsf(m[0]*x + m[2]*y + m[4]) - frag->scissorExt[0];
+	scy = fabsf(m[1]*x + m[3]*y + m[5]) - frag->scissorExt[1];
+	scx = 0.5f - scx * frag->scissorScale[0];
+	scy = 0.5f - scy * frag->scissorScale[1];
+	return swnvg__clampf(scx, 0.0f, 1.0f) * swnvg__clampf(scy, 0.0f, 1.0f);
+}
+
+static int swnvg__wrapCoord(int i, int size, int wrap)
+{
+	if (wrap == NVG_TEXTURE_WRAP_REPEAT) {
+		i %= size;
+		return i < 0 ? i + size : i;
+	}
+	if (wrap == NVG_TEXTURE_WRAP_MIRROR) {
+		int period = size * 2;
+		i %= period;
+		if (i < 0) i += period;
+		return i < size ? i : period - 1 - i;
+	}
+	if (wrap == NVG_TEXTURE_WRAP_CLAMP_EDGE)
+		return i < 0 ? 0 : (i >= size ? size - 1 : i);
+	// Clamp to border, the border color is transparent black
+	return (i < 0 || i >= size) ? -1 : i;
+}
+
+static void swnvg__texel(const SWNVGtexture* tex, int x, int y, int wrap, float* out)
+{
+	const unsigned char* p;
+	x = swnvg__wrapCoord(x, tex->width, wrap);
+	y = swnvg__wrapCoord(y, tex->height, wrap);
+	if (x < 0 || y < 0) {
+		out[0] = out[1] = out[2] = out[3] = 0.0f;
+		return;
+	}
+	if (tex->type == NVG_TEXTURE_RGBA) {
+		p = &tex->data[((size_t)y * tex->width + x) * 4];
+		out[0] = p[0] * (1.0f / 255.0f);
+		out[1] = p[1] * (1.0f / 255.0f);
+		out[2] = p[2] * (1.0f / 255.0f);
+		out[3] = p[3] * (1.0f / 255.0f);
+	} else {
+		p = &tex->data[(size_t)y * tex->width + x];
+		out[0] = p[0] * (1.0f / 255.0f);
+		out[1] = 0.0f;
+		out[2] = 0.0f;
+		out[3] = 1.0f;
+	}
+}
+
+static void swnvg__sample(const SWNVGpass* pass, float s, float t, float* out)
+{
+	const SWNVGtexture* tex = pass->tex;
+	float tx, ty, fx, fy, c00[4], c10[4], c01[4], c11[4];
+	int x0, y0, i;
+
+	if (tex == NULL || tex->data == NULL) {
+		out[0] = out[1] = out[2] = out[3] = 0.0f;
+		return;
+	}
+
+	tx = s * (float)tex->width;
+	ty = t * (float)tex->height;
+	if (pass->textureFilterMode == NVG_TEXTURE_FILTER_NEAREST) {
+		swnvg__texel(tex, (int)floorf(tx), (int)floorf(ty), pass->textureWrapMode, out);
+		return;
+	}
+
+	tx -= 0.5f;
+	ty -= 0.5f;
+	x0 = (int)floorf(tx);
+	y0 = (int)floorf(ty);
+	fx = tx - (float)x0;
+	fy = ty - (float)y0;
+	swnvg__texel(tex, x0, y0, pass->textureWrapMode, c00);
+	swnvg__texel(tex, x0+1, y0, pass->textureWrapMode, c10);
+	swnvg__texel(tex, x0, y0+1, pass->textureWrapMode, c01);
+	swnvg__texel(tex, x0+1, y0+1, pass->textureWrapMode, c11);
+	for (i = 0; i < 4; i++) {
+		float top = c00[i] + (c10[i] - c00[i]) * fx;
+		float bottom = c01[i] + (c11[i] - c01[i]) * fx;
+		out[i] = top + (bottom - top) * fy;
+	}
+}
+
+static void swnvg__applyTexType(int texType, float* color)
+{
+	if (texType == 1) {
+		color[0] *= color[3];
+		color[1] *= color[3];
+		color[2] *= color[3];
+	} else if (texType == 2) {
+		color[1] = color[2] = color[3] = color[0];
+	}
+}
+
+// Returns 0 if the fragment is discarded.
+static int swnvg__shade(const SWNVGcontext* sw, const SWNVGpass* pass, float x, float y, float u, float v, float* color)
+{
+	const SWNVGfragUniforms* frag = pass->frag;
+	const float* m = frag->paintMat;
+	float scissor = swnvg__scissorMask(frag, x, y);
+	float strokeAlpha = 1.0f;
+	float alpha;
+	int i;
+
+	if (sw->flags & NVGSW_ANTIALIAS) {
+		strokeAlpha = swnvg__minf(1.0f, (1.0f - fabsf(u*2.0f - 1.0f)) * frag->strokeMult) * swnvg__minf(1.0f, v);
+		if (strokeAlpha < frag->strokeThr) return 0;
+	}
+
+	if (frag->type == SWNVG_SHADER_FILLGRAD) {
+		float d = 0.0f;
+		if (!frag->solid) {
+			float px = m[0]*x + m[2]*y + m[4];
+			float py = m[1]*x + m[3]*y + m[5];
+			d = swnvg__clampf((swnvg__sdroundrect(px, py, frag->extent[0], frag->extent[1], frag->radius) + frag->feather*0.5f) / frag->feather, 0.0f, 1.0f);
+		}
+		alpha = strokeAlpha * scissor;
+		for (i = 0; i < 4; i++)
+			color[i] = (frag->innerCol.rgba[i] + (frag->outerCol.rgba[i] - frag->innerCol.rgba[i]) * d) * alpha;
+	} else if (frag->type == SWNVG_SHADER_FILLIMG) {
+		float px = (m[0]*x + m[2]*y + m[4]) / frag->extent[0];
+		float py = (m[1]*x + m[3]*y + m[5]) / frag->extent[1];
+		swnvg__sample(pass, px, py, color);
+		swnvg__applyTexType(frag->texType, color);
+		alpha = strokeAlpha * scissor;
+		for (i = 0; i < 4; i++)
+			color[i] *= frag->innerCol.rgba[i] * alpha;
+	} else if (frag->type == SWNVG_SHADER_SIMPLE) {
+		color[0] = color[1] = color[2] = color[3] = 1.0f;
+	} else {
+		swnvg__sample(pass, u, v, color);
+		swnvg__applyTexType(frag->texType, color);
+		for (i = 0; i < 4; i++)
+			color[i] *= scissor * frag->innerCol.rgba[i];
+	}
+
+	return 1;
+}
+
+static float swnvg__blendFactor(int factor, const float* src, const float* dst, int channel)
+{
+	switch (factor) {
+	case NVG_ZERO:					return 0.0f;
+	case NVG_ONE:					return 1.0f;
+	case NVG_SRC_COLOR:				return src[channel];
+	case NVG_ONE_MINUS_SRC_COLOR:	return 1.0f - src[channel];
+	case NVG_DST_COLOR:				return dst[channel];
+	case NVG_ONE_MINUS_DST_COLOR:	return 1.0f - dst[channel];
+	case NVG_SRC_ALPHA:				return src[3];
+	case NVG_ONE_MINUS_SRC_ALPHA:	return 1.0f - src[3];
+	case NVG_DST_ALPHA:				return dst[3];
+	case NVG_ONE_MINUS_DST_ALPHA:	return 1.0f - dst[3];
+	case NVG_SRC_ALPHA_SATURATE:	return channel == 3 ? 1.0f : swnvg__minf(src[3], 1.0f - dst[3]);
+	default:						return 0.0f;
+	}
+}
+
+static unsigned char swnvg__toByte(float v)
+{
+	return (unsigned char)(swnvg__clampf(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+static void swnvg__blend(const NVGcompositeOperationState* op, const float* src, unsigned char* pixel)
+{
+	float dst[4], s[4];
+	int i;
+
+	// Fixed point color buffers clamp the fragment color before blending
+	for (i = 0; i < 4; i++)
+		s[i] = swnvg__clampf(src[i], 0.0f, 1.0f);
+
+	if (op->blendEquation == NVG_BLEND_EQUATION_ADD && op->srcRGB == NVG_ONE && op->dstRGB == NVG_ONE_MINUS_SRC_ALPHA &&
+		op->srcAlpha == NVG_ONE && op->dstAlpha == NVG_ONE_MINUS_SRC_ALPHA) {
+		// Premultiplied source-over, by far the most common case
+		float inv = 1.0f - s[3];
+		for (i = 0; i < 4; i++)
+			pixel[i] = swnvg__toByte(s[i] + pixel[i] * (1.0f / 255.0f) * inv);
+		return;
+	}
+
+	for (i = 0; i < 4; i++)
+		dst[i] = pixel[i] * (1.0f / 255.0f);
+
+	for (i = 0; i < 4; i++) {
+		float sf = swnvg__blendFactor(i < 3 ? op->srcRGB : op->srcAlpha, s, dst, i);
+		float df = swnvg__blendFactor(i < 3 ? op->dstRGB : op->dstAlpha, s, dst, i);
+		float r;
+		if (op->blendEquation == NVG_BLEND_EQUATION_SUBTRACT)
+			r = dst[i] * df - s[i] * sf;	// GL_FUNC_REVERSE_SUBTRACT
+		else if (op->blendEquation == NVG_BLEND_EQUATION_MIN)
+			r = swnvg__minf(s[i], dst[i]);
+		else if (op->blendEquation == NVG_BLEND_EQUATION_MAX)
+			r = swnvg__maxf(s[i], dst[i]);
+		else
+			r = s[i] * sf + dst[i] * df;
+		pixel[i] = swnvg__toByte(r);
+	}
+}
+
+static void swnvg__blendSpan(const NVGcompositeOperationState* op, const float* colors, const unsigned char* mask, unsigned char* pixels, int n)
+{
+	int i;
+
+	if (op->blendEquation == NVG_BLEND_EQUATION_ADD && op->srcRGB == NVG_ONE && op->dstRGB == NVG_ONE_MINUS_SRC_ALPHA &&
+		op->srcAlpha == NVG_ONE && op->dstAlpha == NVG_ONE_MINUS_SRC_ALPHA) {
+#ifdef SWNVG_SSE2
+		// Premultiplied source-over, one pixel per register: dst = src*255 + dst*(1-srcA)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 k255 = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128i zeroi = _mm_setzero_si128();
+		for (i = 0; i < n; i++) {
+			__m128 src, inv, dst, res;
+			__m128i d;
+			int packed;
+			if (!mask[i]) continue;
+			src = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&colors[i*4]), zero), one);
+			inv = _mm_sub_ps(one, _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3)));
+			memcpy(&packed, &pixels[i*4], 4);
+			d = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zeroi), zeroi);
+			dst = _mm_cvtepi32_ps(d);
+			res = _mm_add_ps(_mm_add_ps(_mm_mul_ps(src, k255), _mm_mul_ps(dst, inv)), half);
+			d = _mm_cvttps_epi32(res);
+			d = _mm_packus_epi16(_mm_packs_epi32(d, d), zeroi);
+			packed = _mm_cvtsi128_si32(d);
+			memcpy(&pixels[i*4], &packed, 4);
+		}
+#else
+		for (i = 0; i < n; i++) {
+			const float* src = &colors[i*4];
+			unsigned char* pixel = &pixels[i*4];
+			float inv;
+			if (!mask[i]) continue;
+			inv = 1.0f - swnvg__clampf(src[3], 0.0f, 1.0f);
+			pixel[0] = swnvg__toByte(src[0] + pixel[0] * (1.0f / 255.0f) * inv);
+			pixel[1] = swnvg__toByte(src[1] + pixel[1] * (1.0f / 255.0f) * inv);
+			pixel[2] = swnvg__toByte(src[2] + pixel[2] * (1.0f / 255.0f) * inv);
+			pixel[3] = swnvg__toByte(src[3] + pixel[3] * (1.0f / 255.0f) * inv);
+		}
+#endif
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (mask[i])
+			swnvg__blend(op, &colors[i*4], &pixels[i*4]);
+	}
+}
+
+// Runs n fragments of one row, n never exceeds the tile size.
+static void swnvg__span(SWNVGcontext* sw, const SWNVGpass* pass, int x, int y, int n,
+						float u, float v, float dudx, float dvdx, int front)
+{
+	size_t index = (size_t)y * sw->width + x;
+	unsigned char* stencil = &sw->stencil[index];
+	unsigned char mask[SWNVG_TILE_SIZE];
+	float colors[SWNVG_TILE_SIZE * 4];
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if (pass->stencilFunc == SWNVG_STENCIL_EQUAL)
+			mask[i] = stencil[i] == 0;
+		else if (pass->stencilFunc == SWNVG_STENCIL_NOTEQUAL)
+			mask[i] = stencil[i] != 0;
+		else
+			mask[i] = 1;
+	}
+
+	if (pass->writeColor) {
+		float fy = ((float)y + 0.5f) / sw->scale[1];
+		// Without a scissor an image shader with fixed texture coordinates is the same for every pixel
+		int constant = pass->frag->type == SWNVG_SHADER_IMG && !pass->frag->scissor && dudx == 0.0f && dvdx == 0.0f;
+		int shaded = -1;
+		for (i = 0; i < n; i++) {
+			float fx;
+			if (!mask[i]) continue;
+			if (shaded >= 0) {
+				memcpy(&colors[i*4], &colors[shaded*4], sizeof(float) * 4);
+				continue;
+			}
+			fx = ((float)(x + i) + 0.5f) / sw->scale[0];
+			mask[i] = (unsigned char)swnvg__shade(sw, pass, fx, fy, u + dudx * (float)i, v + dvdx * (float)i, &colors[i*4]);
+			if (constant && mask[i]) shaded = i;
+		}
+		swnvg__blendSpan(&pass->blendFunc, colors, mask, &sw->pixels[index * 4], n);
+	}
+
+	if (pass->stencilOp == SWNVG_STENCIL_KEEP) return;
+	for (i = 0; i < n; i++) {
+		if (!mask[i]) continue;
+		switch (pass->stencilOp) {
+		case SWNVG_STENCIL_INCR:	if (stencil[i] < 255) stencil[i]++; break;
+		case SWNVG_STENCIL_ZERO:	stencil[i] = 0; break;
+		case SWNVG_STENCIL_WINDING:	stencil[i] = (unsigned char)(front ? stencil[i] + 1 : stencil[i] - 1); break;
+		default: break;
+		}
+	}
+}
+
+//
+// Rasterizer
+//
+
+static long long swnvg__snap(float v, float scale)
+{
+	v = swnvg__clampf(v * scale, -SWNVG_MAX_COORD, SWNVG_MAX_COORD);
+	return (long long)floorf(v * SWNVG_SUBPIXEL_ONE + 0.5f);
+}
+
+static void swnvg__triangle(SWNVGcontext* sw, const SWNVGpass* pass, const SWNVGrect* clip,
+							const NVGvertex* v0, const NVGvertex* v1, const NVGvertex* v2)
+{
+	const NVGvertex* vt[3];
+	long long x[3], y[3], area, e[3], dx[3], dy[3], rowE[3], bias[3];
+	float invArea, dudx, dvdx;
+	int i, front, minx, miny, maxx, maxy, px, py;
+
+	x[0] = swnvg__snap(v0->x, sw->scale[0]); y[0] = swnvg__snap(v0->y, sw->scale[1]);
+	x[1] = swnvg__snap(v1->x, sw->scale[0]); y[1] = swnvg__snap(v1->y, sw->scale[1]);
+	x[2] = swnvg__snap(v2->x, sw->scale[0]); y[2] = swnvg__snap(v2->y, sw->scale[1]);
+	vt[0] = v0; vt[1] = v1; vt[2] = v2;
+
+	area = (x[1]-x[0])*(y[2]-y[0]) - (x[2]-x[0])*(y[1]-y[0]);
+	if (area == 0) return;
+
+	// The GL back-end flips y, so GL's counter-clockwise front faces are negative areas here.
+	front = area < 0;
+	if (pass->cull && !front) return;
+	if (area < 0) {
+		long long t;
+		const NVGvertex* tv;
+		t = x[1]; x[1] = x[2]; x[2] = t;
+		t = y[1]; y[1] = y[2]; y[2] = t;
+		tv = vt[1]; vt[1] = vt[2]; vt[2] = tv;
+		area = -area;
+	}
+
+	minx = (int)(swnvg__mini((int)x[0], swnvg__mini((int)x[1], (int)x[2])) >> SWNVG_SUBPIXEL_BITS);
+	miny = (int)(swnvg__mini((int)y[0], swnvg__mini((int)y[1], (int)y[2])) >> SWNVG_SUBPIXEL_BITS);
+	maxx = (int)(swnvg__maxi((int)x[0], swnvg__maxi((int)x[1], (int)x[2])) >> SWNVG_SUBPIXEL_BITS);
+	maxy = (int)(swnvg__maxi((int)y[0], swnvg__maxi((int)y[1], (int)y[2])) >> SWNVG_SUBPIXEL_BITS);
+	minx = swnvg__maxi(minx, clip->x0);
+	miny = swnvg__maxi(miny, clip->y0);
+	maxx = swnvg__mini(maxx, clip->x1 - 1);
+	maxy = swnvg__mini(maxy, clip->y1 - 1);
+	if (minx > maxx || miny > maxy) return;
+
+	// Edge i is opposite vertex i, so e[i] / area is the barycentric weight of vertex i.
+	for (i = 0; i < 3; i++) {
+		int a = (i + 1) % 3, b = (i + 2) % 3;
+		long long ex = x[b] - x[a], ey = y[b] - y[a];
+		long long cx = ((long long)minx << SWNVG_SUBPIXEL_BITS) + SWNVG_SUBPIXEL_ONE/2;
+		long long cy = ((long long)miny << SWNVG_SUBPIXEL_BITS) + SWNVG_SUBPIXEL_ONE/2;
+		rowE[i] = ex * (cy - y[a]) - ey * (cx - x[a]);
+		dx[i] = -ey * SWNVG_SUBPIXEL_ONE;
+		dy[i] = ex * SWNVG_SUBPIXEL_ONE;
+		// Top-left fill rule, pixels exactly on a right or bottom edge belong to the neighbour
+		bias[i] = (ey < 0 || (ey == 0 && ex > 0)) ? 0 : -1;
+	}
+
+	// u and v are affine across the triangle, so they step by a constant per pixel
+	invArea = 1.0f / (float)area;
+	dudx = ((vt[0]->u - vt[2]->u) * (float)dx[0] + (vt[1]->u - vt[2]->u) * (float)dx[1]) * invArea;
+	dvdx = ((vt[0]->v - vt[2]->v) * (float)dx[0] + (vt[1]->v - vt[2]->v) * (float)dx[1]) * invArea;
+
+	for (py = miny; py <= maxy; py++) {
+		int start;
+		e[0] = rowE[0]; e[1] = rowE[1]; e[2] = rowE[2];
+		rowE[0] += dy[0]; rowE[1] += dy[1]; rowE[2] += dy[2];
+
+		// Find the covered span of this row, triangles are convex so there is at most one
+		for (px = minx; px <= maxx; px++) {
+			if (((e[0] + bias[0]) | (e[1] + bias[1]) | (e[2] + bias[2])) >= 0) break;
+			e[0] += dx[0]; e[1] += dx[1]; e[2] += dx[2];
+		}
+		if (px > maxx) continue;
+		start = px;
+		{
+			float w0 = (float)e[0] * invArea;
+			float w1 = (float)e[1] * invArea;
+			float w2 = 1.0f - w0 - w1;
+			float u = vt[0]->u*w0 + vt[1]->u*w1 + vt[2]->u*w2;
+			float v = vt[0]->v*w0 + vt[1]->v*w1 + vt[2]->v*w2;
+			for (; px <= maxx; px++) {
+				if (((e[0] + bias[0]) | (e[1] + bias[1]) | (e[2] + bias[2])) < 0) break;
+				e[0] += dx[0]; e[1] += dx[1]; e[2] += dx[2];
+			}
+			swnvg__span(sw, pass, start, py, px - start, u, v, dudx, dvdx, front);
+		}
+	}
+}
+
+static void swnvg__drawArrays(SWNVGcontext* sw, const SWNVGpass* pass, const SWNVGrect* clip, int prim, int first, int count)
+{
+	const NVGvertex* v = &sw->verts[first];
+	int i;
+
+	if (prim == SWNVG_PRIM_TRIANGLES) {
+		for (i = 0; i + 2 < count; i += 3)
+			swnvg__triangle(sw, pass, clip, &v[i], &v[i+1], &v[i+2]);
+	} else if (prim == SWNVG_PRIM_STRIP) {
+		// Odd triangles are reversed so the whole strip keeps a consistent facing
+		for (i = 0; i + 2 < count; i++) {
+			if (i & 1)
+				swnvg__triangle(sw, pass, clip, &v[i+1], &v[i], &v[i+2]);
+			else
+				swnvg__triangle(sw, pass, clip, &v[i], &v[i+1], &v[i+2]);
+		}
+	} else {
+		for (i = 1; i + 1 < count; i++)
+			swnvg__triangle(sw, pass, clip, &v[0], &v[i], &v[i+1]);
+	}
+}
+
+static void swnvg__setPass(SWNVGcontext* sw, SWNVGpass* pass, const SWNVGcall* call, int uniformOffset)
+{
+	memset(pass, 0, sizeof(*pass));
+	pass->frag = &sw->uniforms[uniformOffset];
+	pass->tex = call->image != 0 ? swnvg__findTexture(sw, call->image) : NULL;
+	pass->textureFilterMode = call->textureFilterMode;
+	pass->textureWrapMode = call->textureWrapMode;
+	pass->blendFunc = call->blendFunc;
+	pass->cull = 1;
+	pass->stencilFunc = SWNVG_STENCIL_ALWAYS;
+	pass->stencilOp = SWNVG_STENCIL_KEEP;
+	pass->writeColor = 1;
+}
+
+static void swnvg__fill(SWNVGcontext* sw, const SWNVGcall* call, const SWNVGrect* clip)
+{
+	const SWNVGpath* paths = &sw->paths[call->pathOffset];
+	int i, npaths = call->pathCount;
+	SWNVGpass pass;
+
+	// Draw shapes into the stencil using the non-zero winding rule
+	swnvg__setPass(sw, &pass, call, call->uniformOffset);
+	pass.cull = 0;
+	pass.stencilOp = SWNVG_STENCIL_WINDING;
+	pass.writeColor = 0;
+	for (i = 0; i < npaths; i++)
+		swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_FAN, paths[i].fillOffset, paths[i].fillCount);
+
+	swnvg__setPass(sw, &pass, call, call->uniformOffset + 1);
+	if (sw->flags & NVGSW_ANTIALIAS) {
+		// Draw fringes
+		pass.stencilFunc = SWNVG_STENCIL_EQUAL;
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+	}
+
+	// Draw fill
+	pass.stencilFunc = SWNVG_STENCIL_NOTEQUAL;
+	pass.stencilOp = SWNVG_STENCIL_ZERO;
+	swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, call->triangleOffset, call->triangleCount);
+}
+
+static void swnvg__convexFill(SWNVGcontext* sw, const SWNVGcall* call, const SWNVGrect* clip)
+{
+	const SWNVGpath* paths = &sw->paths[call->pathOffset];
+	int i, npaths = call->pathCount;
+	SWNVGpass pass;
+
+	swnvg__setPass(sw, &pass, call, call->uniformOffset);
+	for (i = 0; i < npaths; i++)
+		swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_FAN, paths[i].fillOffset, paths[i].fillCount);
+	if (sw->flags & NVGSW_ANTIALIAS) {
+		// Draw fringes
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+	}
+}
+
+static void swnvg__stroke(SWNVGcontext* sw, const SWNVGcall* call, const SWNVGrect* clip)
+{
+	const SWNVGpath* paths = &sw->paths[call->pathOffset];
+	int i, npaths = call->pathCount;
+	SWNVGpass pass;
+
+	if (sw->flags & NVGSW_STENCIL_STROKES) {
+		// Fill the stroke base without overlap
+		swnvg__setPass(sw, &pass, call, call->uniformOffset + 1);
+		pass.stencilFunc = SWNVG_STENCIL_EQUAL;
+		pass.stencilOp = SWNVG_STENCIL_INCR;
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+
+		// Draw anti-aliased pixels.
+		swnvg__setPass(sw, &pass, call, call->uniformOffset);
+		pass.stencilFunc = SWNVG_STENCIL_EQUAL;
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+
+		// Clear stencil buffer.
+		pass.stencilFunc = SWNVG_STENCIL_ALWAYS;
+		pass.stencilOp = SWNVG_STENCIL_ZERO;
+		pass.writeColor = 0;
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+	} else {
+		swnvg__setPass(sw, &pass, call, call->uniformOffset);
+		for (i = 0; i < npaths; i++)
+			swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_STRIP, paths[i].strokeOffset, paths[i].strokeCount);
+	}
+}
+
+static void swnvg__triangles(SWNVGcontext* sw, const SWNVGcall* call, const SWNVGrect* clip)
+{
+	SWNVGpass pass;
+	swnvg__setPass(sw, &pass, call, call->uniformOffset);
+	swnvg__drawArrays(sw, &pass, clip, SWNVG_PRIM_TRIANGLES, call->triangleOffset, call->triangleCount);
+}
+
+static void swnvg__executeCall(SWNVGcontext* sw, const SWNVGcall* call, const SWNVGrect* clip)
+{
+	if (call->type == SWNVG_FILL)
+		swnvg__fill(sw, call, clip);
+	else if (call->type == SWNVG_CONVEXFILL)
+		swnvg__convexFill(sw, call, clip);
+	else if (call->type == SWNVG_STROKE)
+		swnvg__stroke(sw, call, clip);
+	else if (call->type == SWNVG_TRIANGLES)
+		swnvg__triangles(sw, call, clip);
+}
+
+static void swnvg__renderCancel(void* uptr) {
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	sw->nverts = 0;
+	sw->npaths = 0;
+	sw->ncalls = 0;
+	sw->nuniforms = 0;
+}
+
+static void swnvg__renderTile(SWNVGcontext* sw, int tile)
+{
+	SWNVGrect clip;
+	int i, tx = tile % sw->tilesX, ty = tile / sw->tilesX;
+
+	clip.x0 = tx * SWNVG_TILE_SIZE;
+	clip.y0 = ty * SWNVG_TILE_SIZE;
+	clip.x1 = swnvg__mini(clip.x0 + SWNVG_TILE_SIZE, sw->width);
+	clip.y1 = swnvg__mini(clip.y0 + SWNVG_TILE_SIZE, sw->height);
+	for (i = sw->tileBins[tile]; i < sw->tileBins[tile+1]; i++)
+		swnvg__executeCall(sw, &sw->calls[sw->tileCalls[i]], &clip);
+}
+
+// Pulls tiles until none are left, run by the flushing thread and every worker.
+static void swnvg__runTiles(SWNVGcontext* sw)
+{
+	for (;;) {
+		int tile;
+		mtx_lock(&sw->lock);
+		tile = sw->nextTile < sw->ntiles ? sw->nextTile++ : -1;
+		mtx_unlock(&sw->lock);
+		if (tile < 0) break;
+
+		swnvg__renderTile(sw, tile);
+
+		mtx_lock(&sw->lock);
+		if (++sw->tilesDone == sw->ntiles)
+			cnd_broadcast(&sw->done);
+		mtx_unlock(&sw->lock);
+	}
+}
+
+static int swnvg__worker(void* arg)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)arg;
+	int seen = 0;
+
+	mtx_lock(&sw->lock);
+	for (;;) {
+		while (!sw->quit && sw->generation == seen)
+			cnd_wait(&sw->wake, &sw->lock);
+		if (sw->quit) break;
+		seen = sw->generation;
+		mtx_unlock(&sw->lock);
+		swnvg__runTiles(sw);
+		mtx_lock(&sw->lock);
+	}
+	mtx_unlock(&sw->lock);
+	return 0;
+}
+
+static int swnvg__cpuCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+static void swnvg__stopWorkers(SWNVGcontext* sw)
+{
+	int i;
+	mtx_lock(&sw->lock);
+	sw->quit = 1;
+	cnd_broadcast(&sw->wake);
+	mtx_unlock(&sw->lock);
+	for (i = 0; i < sw->nthreads; i++)
+		thrd_join(sw->threads[i], NULL);
+	sw->nthreads = 0;
+	sw->quit = 0;
+}
+
+// threads counts the calling thread as well, so threads - 1 workers are started.
+static void swnvg__startWorkers(SWNVGcontext* sw, int threads)
+{
+	if (threads <= 0) threads = swnvg__cpuCount();
+	threads = swnvg__mini(swnvg__maxi(threads, 1), SWNVG_MAX_THREADS + 1);
+	while (sw->nthreads < threads - 1) {
+		if (thrd_create(&sw->threads[sw->nthreads], swnvg__worker, sw) != thrd_success) break;
+		sw->nthreads++;
+	}
+}
+
+static int swnvg__ensureBins(SWNVGcontext* sw, int ntiles, int nentries)
+{
+	if (sw->ncalls > sw->ccallBounds) {
+		SWNVGrect* bounds = (SWNVGrect*)realloc(sw->callBounds, sizeof(SWNVGrect) * sw->ccalls);
+		if (bounds == NULL) return 0;
+		sw->callBounds = bounds;
+		sw->ccallBounds = sw->ccalls;
+	}
+	if (ntiles + 1 > sw->ctileBins) {
+		int* bins = (int*)realloc(sw->tileBins, sizeof(int) * (ntiles + 1));
+		if (bins == NULL) return 0;
+		sw->tileBins = bins;
+		sw->ctileBins = ntiles + 1;
+	}
+	if (nentries > sw->ctileCalls) {
+		int ctileCalls = swnvg__maxi(nentries, 1024) + sw->ctileCalls/2; // 1.5x Overallocate
+		int* calls = (int*)realloc(sw->tileCalls, sizeof(int) * ctileCalls);
+		if (calls == NULL) return 0;
+		sw->tileCalls = calls;
+		sw->ctileCalls = ctileCalls;
+	}
+	return 1;
+}
+
+// Sorts the calls into the tiles their vertices touch, keeping submission order within each tile.
+// Returns the number of tiles, or -1 if the bins could not be allocated.
+static int swnvg__binCalls(SWNVGcontext* sw)
+{
+	int i, j, tx, ty, nentries = 0;
+	int ntiles;
+
+	sw->tilesX = (sw->width + SWNVG_TILE_SIZE - 1) / SWNVG_TILE_SIZE;
+	sw->tilesY = (sw->height + SWNVG_TILE_SIZE - 1) / SWNVG_TILE_SIZE;
+	ntiles = sw->tilesX * sw->tilesY;
+	if (!swnvg__ensureBins(sw, ntiles, 0)) return -1;
+
+	memset(sw->tileBins, 0, sizeof(int) * (ntiles + 1));
+	for (i = 0; i < sw->ncalls; i++) {
+		const SWNVGcall* call = &sw->calls[i];
+		SWNVGrect* rect = &sw->callBounds[i];
+		float minx = 1e30f, miny = 1e30f, maxx = -1e30f, maxy = -1e30f;
+		for (j = call->vertOffset; j < call->vertOffset + call->vertCount; j++) {
+			minx = swnvg__minf(minx, sw->verts[j].x);
+			miny = swnvg__minf(miny, sw->verts[j].y);
+			maxx = swnvg__maxf(maxx, sw->verts[j].x);
+			maxy = swnvg__maxf(maxy, sw->verts[j].y);
+		}
+		rect->x0 = (int)swnvg__clampf(floorf(minx * sw->scale[0]), 0.0f, (float)sw->width) / SWNVG_TILE_SIZE;
+		rect->y0 = (int)swnvg__clampf(floorf(miny * sw->scale[1]), 0.0f, (float)sw->height) / SWNVG_TILE_SIZE;
+		rect->x1 = (int)swnvg__clampf(floorf(maxx * sw->scale[0]), 0.0f, (float)(sw->width - 1)) / SWNVG_TILE_SIZE;
+		rect->y1 = (int)swnvg__clampf(floorf(maxy * sw->scale[1]), 0.0f, (float)(sw->height - 1)) / SWNVG_TILE_SIZE;
+		if (call->type == SWNVG_NONE || minx > maxx || rect->x0 > rect->x1 || rect->y0 > rect->y1) {
+			rect->x0 = rect->y0 = 0;
+			rect->x1 = rect->y1 = -1;
+			continue;
+		}
+		for (ty = rect->y0; ty <= rect->y1; ty++)
+			for (tx = rect->x0; tx <= rect->x1; tx++)
+				sw->tileBins[ty * sw->tilesX + tx + 1]++;
+		nentries += (rect->x1 - rect->x0 + 1) * (rect->y1 - rect->y0 + 1);
+	}
+
+	if (!swnvg__ensureBins(sw, ntiles, nentries)) return -1;
+	for (i = 0; i < ntiles; i++)
+		sw->tileBins[i+1] += sw->tileBins[i];
+
+	// Fill using tileBins[i] as the write cursor, then shift the offsets back into place
+	for (i = 0; i < sw->ncalls; i++) {
+		const SWNVGrect* rect = &sw->callBounds[i];
+		for (ty = rect->y0; ty <= rect->y1; ty++)
+			for (tx = rect->x0; tx <= rect->x1; tx++)
+				sw->tileCalls[sw->tileBins[ty * sw->tilesX + tx]++] = i;
+	}
+	for (i = ntiles; i > 0; i--)
+		sw->tileBins[i] = sw->tileBins[i-1];
+	sw->tileBins[0] = 0;
+
+	return ntiles;
+}
+
+static void swnvg__renderFlush(void* uptr)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	int ntiles;
+
+	if (sw->ncalls > 0 && sw->pixels != NULL) {
+		sw->scale[0] = sw->view[0] > 0.0f ? (float)sw->width / sw->view[0] : 1.0f;
+		sw->scale[1] = sw->view[1] > 0.0f ? (float)sw->height / sw->view[1] : 1.0f;
+
+		ntiles = swnvg__binCalls(sw);
+		if (ntiles > 0) {
+			// Publish the tiles, workers only pick up tiles while ntiles is set
+			mtx_lock(&sw->lock);
+			sw->ntiles = ntiles;
+			sw->nextTile = 0;
+			sw->tilesDone = 0;
+			sw->generation++;
+			cnd_broadcast(&sw->wake);
+			mtx_unlock(&sw->lock);
+
+			swnvg__runTiles(sw);
+
+			mtx_lock(&sw->lock);
+			while (sw->tilesDone < sw->ntiles)
+				cnd_wait(&sw->done, &sw->lock);
+			sw->ntiles = 0;
+			mtx_unlock(&sw->lock);
+		}
+	}
+
+	// Reset calls
+	sw->nverts = 0;
+	sw->npaths = 0;
+	sw->ncalls = 0;
+	sw->nuniforms = 0;
+}
+
+static int swnvg__maxVertCount(const NVGpath* paths, int npaths)
+{
+	int i, count = 0;
+	for (i = 0; i < npaths; i++) {
+		count += paths[i].nfill;
+		count += paths[i].nstroke;
+	}
+	return count;
+}
+
+static SWNVGcall* swnvg__allocCall(SWNVGcontext* sw)
+{
+	SWNVGcall* ret = NULL;
+	if (sw->ncalls+1 > sw->ccalls) {
+		SWNVGcall* calls;
+		int ccalls = swnvg__maxi(sw->ncalls+1, 128) + sw->ccalls/2; // 1.5x Overallocate
+		calls = (SWNVGcall*)realloc(sw->calls, sizeof(SWNVGcall) * ccalls);
+		if (calls == NULL) return NULL;
+		sw->calls = calls;
+		sw->ccalls = ccalls;
+	}
+	ret = &sw->calls[sw->ncalls++];
+	memset(ret, 0, sizeof(SWNVGcall));
+	return ret;
+}
+
+static int swnvg__allocPaths(SWNVGcontext* sw, int n)
+{
+	int ret = 0;
+	if (sw->npaths+n > sw->cpaths) {
+		SWNVGpath* paths;
+		int cpaths = swnvg__maxi(sw->npaths + n, 128) + sw->cpaths/2; // 1.5x Overallocate
+		paths = (SWNVGpath*)realloc(sw->paths, sizeof(SWNVGpath) * cpaths);
+		if (paths == NULL) return -1;
+		sw->paths = paths;
+		sw->cpaths = cpaths;
+	}
+	ret = sw->npaths;
+	sw->npaths += n;
+	return ret;
+}
+
+static int swnvg__allocVerts(SWNVGcontext* sw, int n)
+{
+	int ret = 0;
+	if (sw->nverts+n > sw->cverts) {
+		NVGvertex* verts;
+		int cverts = swnvg__maxi(sw->nverts + n, 4096) + sw->cverts/2; // 1.5x Overallocate
+		verts = (NVGvertex*)realloc(sw->verts, sizeof(NVGvertex) * cverts);
+		if (verts == NULL) return -1;
+		sw->verts = verts;
+		sw->cverts = cverts;
+	}
+	ret = sw->nverts;
+	sw->nverts += n;
+	return ret;
+}
+
+static int swnvg__allocFragUniforms(SWNVGcontext* sw, int n)
+{
+	int ret = 0;
+	if (sw->nuniforms+n > sw->cuniforms) {
+		SWNVGfragUniforms* uniforms;
+		int cuniforms = swnvg__maxi(sw->nuniforms+n, 128) + sw->cuniforms/2; // 1.5x Overallocate
+		uniforms = (SWNVGfragUniforms*)realloc(sw->uniforms, sizeof(SWNVGfragUniforms) * cuniforms);
+		if (uniforms == NULL) return -1;
+		sw->uniforms = uniforms;
+		sw->cuniforms = cuniforms;
+	}
+	ret = sw->nuniforms;
+	sw->nuniforms += n;
+	return ret;
+}
+
+static void swnvg__vset(NVGvertex* vtx, float x, float y, float u, float v)
+{
+	vtx->x = x;
+	vtx->y = y;
+	vtx->u = u;
+	vtx->v = v;
+}
+
+static void swnvg__copyPaths(SWNVGcontext* sw, const SWNVGcall* call, const NVGpath* paths, int npaths, int offset, int withFill)
+{
+	int i;
+	for (i = 0; i < npaths; i++) {
+		SWNVGpath* copy = &sw->paths[call->pathOffset + i];
+		const NVGpath* path = &paths[i];
+		memset(copy, 0, sizeof(SWNVGpath));
+		if (withFill && path->nfill > 0) {
+			copy->fillOffset = offset;
+			copy->fillCount = path->nfill;
+			memcpy(&sw->verts[offset], path->fill, sizeof(NVGvertex) * path->nfill);
+			offset += path->nfill;
+		}
+		if (path->nstroke > 0) {
+			copy->strokeOffset = offset;
+			copy->strokeCount = path->nstroke;
+			memcpy(&sw->verts[offset], path->stroke, sizeof(NVGvertex) * path->nstroke);
+			offset += path->nstroke;
+		}
+	}
+}
+
+static void swnvg__renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+							  const float* bounds, const NVGpath* paths, int npaths)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGcall* call = swnvg__allocCall(sw);
+	NVGvertex* quad;
+	SWNVGfragUniforms* frag;
+	int maxverts, offset;
+
+	if (call == NULL) return;
+
+	call->type = SWNVG_FILL;
+	call->triangleCount = 4;
+	call->pathOffset = swnvg__allocPaths(sw, npaths);
+	if (call->pathOffset == -1) goto error;
+	call->pathCount = npaths;
+	call->image = paint->image;
+	call->blendFunc = compositeOperation;
+	call->textureFilterMode = paint->textureFilterMode;
+	call->textureWrapMode = paint->textureWrapMode;
+
+	if (npaths == 1 && paths[0].convex)
+	{
+		call->type = SWNVG_CONVEXFILL;
+		call->triangleCount = 0;	// Bounding box fill quad not needed for convex fill
+	}
+
+	// Allocate vertices for all the paths.
+	maxverts = swnvg__maxVertCount(paths, npaths) + call->triangleCount;
+	offset = swnvg__allocVerts(sw, maxverts);
+	if (offset == -1) goto error;
+	call->vertOffset = offset;
+	call->vertCount = maxverts;
+
+	swnvg__copyPaths(sw, call, paths, npaths, offset, 1);
+
+	// Setup uniforms for draw calls
+	if (call->type == SWNVG_FILL) {
+		// Quad
+		call->triangleOffset = offset + swnvg__maxVertCount(paths, npaths);
+		quad = &sw->verts[call->triangleOffset];
+		swnvg__vset(&quad[0], bounds[2], bounds[3], 0.5f, 1.0f);
+		swnvg__vset(&quad[1], bounds[2], bounds[1], 0.5f, 1.0f);
+		swnvg__vset(&quad[2], bounds[0], bounds[3], 0.5f, 1.0f);
+		swnvg__vset(&quad[3], bounds[0], bounds[1], 0.5f, 1.0f);
+
+		call->uniformOffset = swnvg__allocFragUniforms(sw, 2);
+		if (call->uniformOffset == -1) goto error;
+		// Simple shader for stencil
+		frag = &sw->uniforms[call->uniformOffset];
+		memset(frag, 0, sizeof(*frag));
+		frag->strokeThr = -1.0f;
+		frag->type = SWNVG_SHADER_SIMPLE;
+		// Fill shader
+		swnvg__convertPaint(sw, &sw->uniforms[call->uniformOffset + 1], paint, scissor, fringe, fringe, -1.0f);
+	} else {
+		call->uniformOffset = swnvg__allocFragUniforms(sw, 1);
+		if (call->uniformOffset == -1) goto error;
+		// Fill shader
+		swnvg__convertPaint(sw, &sw->uniforms[call->uniformOffset], paint, scissor, fringe, fringe, -1.0f);
+	}
+
+	return;
+
+error:
+	// We get here if call alloc was ok, but something else is not.
+	// Roll back the last call to prevent drawing it.
+	if (sw->ncalls > 0) sw->ncalls--;
+}
+
+static void swnvg__renderStroke(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor, float fringe,
+								float strokeWidth, const NVGpath* paths, int npaths)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGcall* call = swnvg__allocCall(sw);
+	int maxverts, offset;
+
+	if (call == NULL) return;
+
+	call->type = SWNVG_STROKE;
+	call->pathOffset = swnvg__allocPaths(sw, npaths);
+	if (call->pathOffset == -1) goto error;
+	call->pathCount = npaths;
+	call->image = paint->image;
+	call->blendFunc = compositeOperation;
+	call->textureFilterMode = paint->textureFilterMode;
+	call->textureWrapMode = paint->textureWrapMode;
+
+	// Allocate vertices for all the paths.
+	maxverts = swnvg__maxVertCount(paths, npaths);
+	offset = swnvg__allocVerts(sw, maxverts);
+	if (offset == -1) goto error;
+	call->vertOffset = offset;
+	call->vertCount = maxverts;
+
+	swnvg__copyPaths(sw, call, paths, npaths, offset, 0);
+
+	if (sw->flags & NVGSW_STENCIL_STROKES) {
+		// Fill shader
+		call->uniformOffset = swnvg__allocFragUniforms(sw, 2);
+		if (call->uniformOffset == -1) goto error;
+
+		swnvg__convertPaint(sw, &sw->uniforms[call->uniformOffset], paint, scissor, strokeWidth, fringe, -1.0f);
+		swnvg__convertPaint(sw, &sw->uniforms[call->uniformOffset + 1], paint, scissor, strokeWidth, fringe, 1.0f - 0.5f/255.0f);
+
+	} else {
+		// Fill shader
+		call->uniformOffset = swnvg__allocFragUniforms(sw, 1);
+		if (call->uniformOffset == -1) goto error;
+		swnvg__convertPaint(sw, &sw->uniforms[call->uniformOffset], paint, scissor, strokeWidth, fringe, -1.0f);
+	}
+
+	return;
+
+error:
+	// We get here if call alloc was ok, but something else is not.
+	// Roll back the last call to prevent drawing it.
+	if (sw->ncalls > 0) sw->ncalls--;
+}
+
+static void swnvg__renderTriangles(void* uptr, NVGpaint* paint, NVGcompositeOperationState compositeOperation, NVGscissor* scissor,
+								   const NVGvertex* verts, int nverts)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	SWNVGfragUniforms* frag;
+	int i, vertOffset, uniformOffset;
+
+	// Allocate vertices for all the triangles.
+	vertOffset = swnvg__allocVerts(sw, nverts);
+	if (vertOffset == -1) return;
+	memcpy(&sw->verts[vertOffset], verts, sizeof(NVGvertex) * nverts);
+
+	// Fill shader, shared by every chunk
+	uniformOffset = swnvg__allocFragUniforms(sw, 1);
+	if (uniformOffset == -1) return;
+	frag = &sw->uniforms[uniformOffset];
+	swnvg__convertPaint(sw, frag, paint, scissor, 1.0f, 1.0f, -1.0f);
+	frag->type = SWNVG_SHADER_IMG;
+
+	for (i = 0; i < nverts; ) {
+		SWNVGcall* call;
+		float minx = 1e30f, miny = 1e30f, maxx = -1e30f, maxy = -1e30f;
+		int first = i;
+
+		// Grow the chunk until it would no longer fit in a couple of tiles
+		for (; i + 2 < nverts && i - first < SWNVG_TRIANGLE_CHUNK; i += 3) {
+			const NVGvertex* v = &verts[i];
+			float x0 = swnvg__minf(minx, swnvg__minf(v[0].x, swnvg__minf(v[1].x, v[2].x)));
+			float y0 = swnvg__minf(miny, swnvg__minf(v[0].y, swnvg__minf(v[1].y, v[2].y)));
+			float x1 = swnvg__maxf(maxx, swnvg__maxf(v[0].x, swnvg__maxf(v[1].x, v[2].x)));
+			float y1 = swnvg__maxf(maxy, swnvg__maxf(v[0].y, swnvg__maxf(v[1].y, v[2].y)));
+			if (i > first && (x1 - x0 > 2 * SWNVG_TILE_SIZE || y1 - y0 > 2 * SWNVG_TILE_SIZE)) break;
+			minx = x0; miny = y0; maxx = x1; maxy = y1;
+		}
+		if (i == first) break;
+
+		call = swnvg__allocCall(sw);
+		if (call == NULL) return;
+		call->type = SWNVG_TRIANGLES;
+		call->image = paint->image;
+		call->blendFunc = compositeOperation;
+		call->textureFilterMode = paint->textureFilterMode;
+		call->textureWrapMode = paint->textureWrapMode;
+		call->triangleOffset = vertOffset + first;
+		call->triangleCount = i - first;
+		call->vertOffset = call->triangleOffset;
+		call->vertCount = call->triangleCount;
+		call->uniformOffset = uniformOffset;
+	}
+}
+
+static void swnvg__renderDelete(void* uptr)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)uptr;
+	int i;
+	if (sw == NULL) return;
+
+	swnvg__stopWorkers(sw);
+	mtx_destroy(&sw->lock);
+	cnd_destroy(&sw->wake);
+	cnd_destroy(&sw->done);
+
+	swnvg__bindTarget(sw, NULL);
+	free(sw->targetStencil);
+
+	for (i = 0; i < sw->ntextures; i++)
+		free(sw->textures[i].data);
+	free(sw->textures);
+
+	free(sw->pixels);
+	free(sw->stencil);
+
+	free(sw->paths);
+	free(sw->verts);
+	free(sw->uniforms);
+	free(sw->calls);
+
+	free(sw->callBounds);
+	free(sw->tileBins);
+	free(sw->tileCalls);
+
+	free(sw);
+}
+
+static int swnvg__allocFramebuffer(SWNVGcontext* sw, int width, int height)
+{
+	size_t count = (size_t)swnvg__maxi(width, 1) * (size_t)swnvg__maxi(height, 1);
+	unsigned char* pixels = (unsigned char*)calloc(count, 4);
+	unsigned char* stencil = (unsigned char*)calloc(count, 1);
+	int target = sw->target;
+	if (pixels == NULL || stencil == NULL) {
+		free(pixels);
+		free(stencil);
+		return 0;
+	}
+
+	// an image bound as the render target stays bound
+	swnvg__bindTarget(sw, NULL);
+	free(sw->pixels);
+	free(sw->stencil);
+	sw->pixels = pixels;
+	sw->stencil = stencil;
+	sw->width = swnvg__maxi(width, 1);
+	sw->height = swnvg__maxi(height, 1);
+	if (target != 0)
+		swnvg__bindTarget(sw, swnvg__findTexture(sw, target));
+	return 1;
+}
+
+NVGcontext* nvgCreateSW(int flags, int width, int height)
+{
+	NVGparams params;
+	NVGcontext* ctx = NULL;
+	SWNVGcontext* sw = (SWNVGcontext*)malloc(sizeof(SWNVGcontext));
+	if (sw == NULL) goto error;
+	memset(sw, 0, sizeof(SWNVGcontext));
+
+	if (!swnvg__allocFramebuffer(sw, width, height)) {
+		free(sw);
+		goto error;
+	}
+
+	mtx_init(&sw->lock, mtx_plain);
+	cnd_init(&sw->wake);
+	cnd_init(&sw->done);
+	swnvg__startWorkers(sw, 0);
+
+	memset(&params, 0, sizeof(params));
+	params.renderCreate = swnvg__renderCreate;
+	params.renderCreateTexture = swnvg__renderCreateTexture;
+	params.renderDeleteTexture = swnvg__renderDeleteTexture;
+	params.renderUpdateTexture = swnvg__renderUpdateTexture;
+	params.renderGetTexturePixelData = swnvg__renderGetTexturePixelData;
+	params.renderGetTextureSize = swnvg__renderGetTextureSize;
+	params.renderViewport = swnvg__renderViewport;
+	params.renderCancel = swnvg__renderCancel;
+	params.renderFlush = swnvg__renderFlush;
+	params.renderFill = swnvg__renderFill;
+	params.renderStroke = swnvg__renderStroke;
+	params.renderTriangles = swnvg__renderTriangles;
+	params.renderDelete = swnvg__renderDelete;
+	params.userPtr = sw;
+	params.edgeAntiAlias = flags & NVGSW_ANTIALIAS ? 1 : 0;
+
+	sw->flags = flags;
+	sw->view[0] = (float)sw->width;
+	sw->view[1] = (float)sw->height;
+
+	ctx = nvgCreateInternal(&params);
+	if (ctx == NULL) goto error;
+
+	return ctx;
+
+error:
+	// 'sw' is freed by nvgDeleteInternal.
+	if (ctx != NULL) nvgDeleteInternal(ctx);
+	return NULL;
+}
+
+void nvgDeleteSW(NVGcontext* ctx)
+{
+	nvgDeleteInternal(ctx);
+}
+
+int nvgswResizeFramebuffer(NVGcontext* ctx, int width, int height)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	if (sw->target == 0 && sw->width == width && sw->height == height) return 1;
+	return swnvg__allocFramebuffer(sw, width, height);
+}
+
+unsigned char* nvgswFramebuffer(NVGcontext* ctx, int* width, int* height)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	if (width) *width = sw->width;
+	if (height) *height = sw->height;
+	return sw->pixels;
+}
+
+void nvgswClear(NVGcontext* ctx, NVGcolor color)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	size_t i, count = (size_t)sw->width * (size_t)sw->height;
+	unsigned char rgba[4];
+	rgba[0] = swnvg__toByte(color.r);
+	rgba[1] = swnvg__toByte(color.g);
+	rgba[2] = swnvg__toByte(color.b);
+	rgba[3] = swnvg__toByte(color.a);
+	for (i = 0; i < count; i++)
+		memcpy(&sw->pixels[i * 4], rgba, 4);
+	memset(sw->stencil, 0, count);
+}
+
+void nvgswSetThreadCount(NVGcontext* ctx, int threads)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	swnvg__stopWorkers(sw);
+	swnvg__startWorkers(sw, threads);
+}
+
+int nvgswBindTarget(NVGcontext* ctx, int image)
+{
+	SWNVGcontext* sw = (SWNVGcontext*)nvgInternalParams(ctx)->userPtr;
+	SWNVGtexture* tex = NULL;
+	if (image != 0) {
+		tex = swnvg__findTexture(sw, image);
+		if (tex == NULL) return 0;
+	}
+	return swnvg__bindTarget(sw, tex);
+}
+
+#endif /* NANOVG_SW_IMPLEMENTATION */